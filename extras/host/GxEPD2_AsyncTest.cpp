@@ -0,0 +1,121 @@
+// Display Library for SPI e-paper panels from Dalian Good Display and boards from Waveshare.
+// Requires HW SPI and Adafruit_GFX. Caution: the e-paper panels require 3.3V supply AND data lines!
+//
+// Display Library based on Demo Example from Good Display: https://www.good-display.com/companyfile/32/
+//
+// Author: Jean-Marc Zingg
+//
+// Version: see library.properties
+//
+// Library: https://github.com/ZinggJM/GxEPD2
+//
+// GxEPD2_AsyncTest: asynchronous upload through GxEPD2_FakeAsyncSPI, for several staging buffer sizes and completion delays;
+// the stream on the panel must be the one of synchronous upload, and the fake's events must show the ping-pong order:
+// at most 2 blocks queued, completed in queue order, all completed before the transfer callback, never a full queue.
+// exit code 0 if all checks pass.
+
+#include "GxEPD2_Host.h"
+#include "GxEPD2_FakeAsyncSPI.h"
+#include <epd/GxEPD2_290_T94.h>
+#include <deque>
+
+static const uint16_t WIDTH = GxEPD2_290_T94::WIDTH;
+static const uint16_t HEIGHT = GxEPD2_290_T94::HEIGHT;
+static uint8_t bitmap[WIDTH / 8 * HEIGHT];
+static uint16_t failures = 0;
+
+static void check(bool ok, const char* what, uint16_t staging_size, uint16_t completion_polls)
+{
+  if (ok) return;
+  printf("FAIL %s, staging buffer %u, completion polls %u\n", what, staging_size, completion_polls);
+  failures++;
+}
+
+static void transferCallback(const void* pv)
+{
+  ((GxEPD2_FakeAsyncSPI*)pv)->events.push_back("callback");
+}
+
+struct Result
+{
+  uint64_t hash, data_bytes;
+  size_t commands;
+  bool busy_after_write; // data phase still running after writeImage() returned
+};
+
+static Result upload(GxEPD2_FakeAsyncSPI* fake, uint8_t* staging_buffer, uint16_t staging_size)
+{
+  GxEPD2_Host::reset();
+  GxEPD2_290_T94 epd(/*CS=*/ 5, /*DC=*/ 17, /*RST=*/ 16, /*BUSY=*/ 4);
+  GxEPD2_HostPanel panel(5, 17, 16, 4);
+  epd.init(0);
+  epd.selectAsyncTransfer(fake, staging_buffer, staging_size);
+  if (fake) epd.setTransferCallback(transferCallback, fake);
+  panel.clear();
+  Result result;
+  epd.writeScreenBuffer(0x55); // fill
+  epd.writeImage(bitmap, 0, 0, WIDTH, HEIGHT); // rows
+  result.busy_after_write = epd.isTransferBusy();
+  epd.writeImage(bitmap, 8, 10, 64, 100, true, true, false); // invert, mirror_y
+  epd.writeImagePart(bitmap, 16, 20, WIDTH, HEIGHT, 24, 30, 40, 50, false, false, true); // pgm
+  epd.writeImageAgain(bitmap, 0, 0, WIDTH, 17);
+  epd.refresh(true); // commands after a transfer
+  epd.writeImage(bitmap, 0, 0, 8, 1); // single byte
+  epd.awaitTransfer();
+  result.hash = panel.hash();
+  result.data_bytes = panel.data_bytes;
+  result.commands = panel.commands.size();
+  return result;
+}
+
+// "queue n" and "done n" in FIFO order, at most 2 queued, no "queue full", "callback" only with nothing queued
+static bool pingPongOrder(const std::vector<std::string>& events)
+{
+  std::deque<std::string> queued;
+  for (const std::string& e : events)
+  {
+    if (e == "queue full") return false;
+    if (e.compare(0, 6, "queue ") == 0)
+    {
+      queued.push_back(e.substr(6));
+      if (queued.size() > 2) return false;
+    }
+    else if (e.compare(0, 5, "done ") == 0)
+    {
+      if (queued.empty() || (queued.front() != e.substr(5))) return false;
+      queued.pop_front();
+    }
+    else if ((e == "callback") && !queued.empty()) return false;
+  }
+  return queued.empty();
+}
+
+int main()
+{
+  GxEPD2_Host::serial_output = false;
+  for (uint32_t i = 0; i < sizeof(bitmap); i++) bitmap[i] = uint8_t(i * 37 + (i >> 8));
+  Result sync = upload(0, 0, 0);
+  const uint16_t staging_sizes[] = {2, 3, 64, 333, 1000, 8192};
+  const uint16_t completion_polls[] = {1, 3, 50};
+  static uint8_t staging_buffer[8192];
+  for (uint16_t size : staging_sizes)
+  {
+    for (uint16_t polls : completion_polls)
+    {
+      GxEPD2_FakeAsyncSPI fake(2, polls, &SPI);
+      Result async = upload(&fake, staging_buffer, size);
+      check(async.hash == sync.hash, "stream differs from synchronous upload", size, polls);
+      check(async.data_bytes == sync.data_bytes, "data bytes differ from synchronous upload", size, polls);
+      check(async.commands == sync.commands, "commands differ from synchronous upload", size, polls);
+      check(fake.wire.size() > 2 * uint32_t(WIDTH / 8) * HEIGHT, "too few bytes through the fake", size, polls);
+      check(pingPongOrder(fake.events), "event order", size, polls);
+      if (polls > 1) // else each block may complete at the first poll
+      {
+        check(fake.max_pending == 2, "no overlap, a block queued only after the previous one completed", size, polls);
+        check(async.busy_after_write, "no overlap, transfer completed within writeImage()", size, polls);
+      }
+    }
+  }
+  printf("GxEPD2_AsyncTest: %u failures\n", failures);
+  return failures ? 1 : 0;
+}
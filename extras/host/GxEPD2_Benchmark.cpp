@@ -0,0 +1,257 @@
+// Display Library for SPI e-paper panels from Dalian Good Display and boards from Waveshare.
+// Requires HW SPI and Adafruit_GFX. Caution: the e-paper panels require 3.3V supply AND data lines!
+//
+// Display Library based on Demo Example from Good Display: https://www.good-display.com/companyfile/32/
+//
+// Author: Jean-Marc Zingg
+//
+// Version: see library.properties
+//
+// Library: https://github.com/ZinggJM/GxEPD2
+//
+// GxEPD2_Benchmark: all driver classes with their display template, also GxEPD2_16G for the IT8951 drivers, update modes and page heights on the host panel model.
+//
+// usage: GxEPD2_Benchmark [driver name part ...]
+//
+// output is CSV on stdout, one line per driver, page height and mode:
+//   driver       driver class
+//   template     display template
+//   page_height  of the display buffer: full height (also for buffers above 64 KB), a quarter of it, 16 lines
+//   pages        number of pages
+//   mode         full      display(false), full buffer only
+//                changed   displayChanged() after drawing a 16x16 box, full buffer only
+//                partial   displayWindow() of the middle quarter, full buffer only
+//                paged     setFullWindow(), firstPage()/nextPage()
+//                paged_partial  setPartialWindow() of the middle quarter, firstPage()/nextPage()
+//                drawPaged drawPaged() with full window
+//                paged_dl  as paged, with display list, more than one page only
+//                shadow    display(true) after drawing a 16x16 box, with shadow buffer, full buffer and GxEPD2_BW only
+//   bytes        SPI bytes, all controllers
+//   transactions SPI transactions
+//   commands     command bytes (DC LOW)
+//   busy_us      modelled BUSY time
+//   time_us      modelled wall time, virtual time of the update
+//   cpu_us       host CPU time of the update, mostly rendering and upload loops
+//   hash         of the command and data stream, changes with any change of the stream
+// the same tree gives the same output, except cpu_us; compare outputs of two trees to find changes.
+
+#include "GxEPD2_Host.h"
+#include <GxEPD2_BW.h>
+#include <GxEPD2_3C.h>
+#include <GxEPD2_4C.h>
+#include <GxEPD2_7C.h>
+#include <GxEPD2_16G.h>
+#include "GxEPD2_BenchmarkDrivers.h"
+#include <inttypes.h>
+#include <time.h>
+
+// pins as in the wiring examples for ESP32, more for drivers with more controllers
+static const int16_t CS = 5, DC = 17, RST = 16, BUSY = 4;
+static const int16_t CS_S1 = 25, CS_M2 = 26, CS_S2 = 27;
+
+template<typename GxEPD2_Type> GxEPD2_Type driver()
+{
+  return GxEPD2_Type(CS, DC, RST, BUSY);
+}
+
+template<> GxEPD2_1085_GDEM1085T51 driver<GxEPD2_1085_GDEM1085T51>()
+{
+  return GxEPD2_1085_GDEM1085T51(CS, DC, RST, BUSY, CS_S1);
+}
+
+template<> GxEPD2_1248 driver<GxEPD2_1248>()
+{
+  return GxEPD2_1248(CS, CS_S1, CS_M2, CS_S2, DC, RST, BUSY);
+}
+
+template<> GxEPD2_1248c driver<GxEPD2_1248c>()
+{
+  return GxEPD2_1248c(CS, CS_S1, CS_M2, CS_S2, DC, RST, BUSY);
+}
+
+// for the display list, enough for drawContent() on all panels
+static uint8_t display_list[65536];
+
+static uint64_t cpuTime() // µs
+{
+  struct timespec ts;
+  clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+  return uint64_t(ts.tv_sec) * 1000000ull + ts.tv_nsec / 1000;
+}
+
+// same content for all: frame, filled boxes in black and color, diagonals of single pixels
+template<typename Display> void drawContent(const void* pv)
+{
+  Display& display = *(Display*)pv;
+  int16_t w = display.width(), h = display.height();
+  display.fillScreen(GxEPD_WHITE);
+  display.fillRect(0, 0, w, 4, GxEPD_BLACK);
+  display.fillRect(0, h - 4, w, 4, GxEPD_BLACK);
+  display.fillRect(w / 8, h / 8, w / 4, h / 4, GxEPD_BLACK);
+  display.fillRect(w / 2, h / 2, w / 4, h / 4, GxEPD_RED);
+  for (int16_t i = 0; i < w && i < h; i++)
+  {
+    display.drawPixel(i, i, GxEPD_BLACK);
+    display.drawPixel(w - 1 - i, i, GxEPD_BLACK);
+  }
+}
+
+class Measurement
+{
+  public:
+    Measurement(GxEPD2_HostPanel& panel) : _panel(panel)
+    {
+      _panel.clear();
+      _spi_bytes = GxEPD2_Host::spi_bytes;
+      _spi_transactions = GxEPD2_Host::spi_transactions;
+      _time = GxEPD2_Host::now();
+      _cpu_time = cpuTime();
+    };
+    void print(const char* driver, const char* display_template, uint16_t page_height, uint16_t pages, const char* mode)
+    {
+      uint64_t cpu_time = cpuTime() - _cpu_time;
+      uint32_t commands = 0;
+      for (const GxEPD2_HostPanel::Command& c : _panel.commands) if (c.command >= 0) commands++;
+      printf("%s,%s,%u,%u,%s,%" PRIu64 ",%" PRIu64 ",%u,%" PRIu64 ",%" PRIu64 ",%" PRIu64 ",%016" PRIx64 "\n",
+             driver, display_template, page_height, pages, mode,
+             GxEPD2_Host::spi_bytes - _spi_bytes, GxEPD2_Host::spi_transactions - _spi_transactions, commands,
+             _panel.busyTime(), GxEPD2_Host::now() - _time, cpu_time, _panel.hash());
+    };
+  private:
+    GxEPD2_HostPanel& _panel;
+    uint64_t _spi_bytes, _spi_transactions, _time, _cpu_time;
+};
+
+// only GxEPD2_BW has the shadow buffer
+template<typename Display> void benchmarkShadow(const char* driver_name, const char* template_name, GxEPD2_HostPanel& panel, Display& display)
+{
+}
+
+template<typename GxEPD2_Type, const uint16_t page_height>
+void benchmarkShadow(const char* driver_name, const char* template_name, GxEPD2_HostPanel& panel, GxEPD2_BW<GxEPD2_Type, page_height>& display)
+{
+  int16_t w = display.width(), h = display.height();
+  uint8_t* shadow = (uint8_t*)malloc(uint32_t(GxEPD2_Type::WIDTH / 8) * page_height);
+  display.setShadowBuffer(shadow);
+  drawContent<GxEPD2_BW<GxEPD2_Type, page_height>>(&display);
+  display.display(true); // writes all, initializes the shadow buffer
+  {
+    Measurement m(panel);
+    display.fillRect(w / 2, h / 2, 16, 16, GxEPD_BLACK);
+    display.display(true);
+    m.print(driver_name, template_name, page_height, 1, "shadow");
+  }
+  display.setShadowBuffer(0);
+  free(shadow);
+}
+
+template<typename Display> void benchmark(const char* driver_name, const char* template_name, Display& display)
+{
+  // records the stream of all controllers (cs -1)
+  GxEPD2_HostPanel panel(-1, DC, RST, BUSY, driver_name);
+  GxEPD2_Host::reset();
+  display.init(0);
+  display.clearScreen(); // initial full refresh, not measured
+  uint16_t page_height = display.pageHeight();
+  uint16_t pages = display.pages();
+  int16_t w = display.width(), h = display.height();
+  if (1 == pages)
+  {
+    {
+      Measurement m(panel);
+      drawContent<Display>(&display);
+      display.display(false);
+      m.print(driver_name, template_name, page_height, pages, "full");
+    }
+    {
+      Measurement m(panel);
+      display.fillRect(w / 2, h / 2, 16, 16, GxEPD_BLACK);
+      display.displayChanged();
+      m.print(driver_name, template_name, page_height, pages, "changed");
+    }
+    {
+      Measurement m(panel);
+      drawContent<Display>(&display);
+      display.displayWindow(w / 4, h / 4, w / 2, h / 2);
+      m.print(driver_name, template_name, page_height, pages, "partial");
+    }
+  }
+  {
+    Measurement m(panel);
+    display.setFullWindow();
+    display.firstPage();
+    do
+    {
+      drawContent<Display>(&display);
+    }
+    while (display.nextPage());
+    m.print(driver_name, template_name, page_height, pages, "paged");
+  }
+  {
+    Measurement m(panel);
+    display.setPartialWindow(w / 4, h / 4, w / 2, h / 2);
+    display.firstPage();
+    do
+    {
+      drawContent<Display>(&display);
+    }
+    while (display.nextPage());
+    m.print(driver_name, template_name, page_height, pages, "paged_partial");
+  }
+  {
+    Measurement m(panel);
+    display.setFullWindow();
+    display.drawPaged(drawContent<Display>, &display);
+    m.print(driver_name, template_name, page_height, pages, "drawPaged");
+  }
+  if (pages > 1)
+  {
+    Measurement m(panel);
+    display.setFullWindow();
+    display.setDisplayList(display_list, sizeof(display_list));
+    display.firstPage();
+    do
+    {
+      drawContent<Display>(&display);
+    }
+    while (display.nextPage());
+    display.setDisplayList(0, 0);
+    m.print(driver_name, template_name, page_height, pages, "paged_dl");
+  }
+  if (1 == pages) benchmarkShadow(driver_name, template_name, panel, display);
+  display.hibernate();
+}
+
+template<typename Display, typename GxEPD2_Type> void benchmark(const char* driver_name, const char* template_name)
+{
+  Display* display = new Display(driver<GxEPD2_Type>()); // buffers can be large
+  benchmark(driver_name, template_name, *display);
+  delete display;
+}
+
+static bool selected(const char* driver_name, int argc, char** argv)
+{
+  if (argc < 2) return true;
+  for (int i = 1; i < argc; i++)
+  {
+    if (strstr(driver_name, argv[i])) return true;
+  }
+  return false;
+}
+
+// full frame buffer, a quarter of it, and 16 rows
+#define GxEPD2_BENCHMARK(GxEPD2_Template, GxEPD2_Type) \
+  if (selected(#GxEPD2_Type, argc, argv)) \
+  { \
+    benchmark<GxEPD2_Template<GxEPD2_Type, GxEPD2_Type::HEIGHT>, GxEPD2_Type>(#GxEPD2_Type, #GxEPD2_Template); \
+    benchmark<GxEPD2_Template<GxEPD2_Type, (GxEPD2_Type::HEIGHT + 3) / 4>, GxEPD2_Type>(#GxEPD2_Type, #GxEPD2_Template); \
+    benchmark<GxEPD2_Template<GxEPD2_Type, 16>, GxEPD2_Type>(#GxEPD2_Type, #GxEPD2_Template); \
+  }
+
+int main(int argc, char** argv)
+{
+  GxEPD2_Host::serial_output = false;
+  printf("driver,template,page_height,pages,mode,bytes,transactions,commands,busy_us,time_us,cpu_us,hash\n");
+  GxEPD2_BENCHMARK_DRIVERS(GxEPD2_BENCHMARK)
+  return 0;
+}
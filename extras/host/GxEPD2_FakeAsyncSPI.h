@@ -0,0 +1,103 @@
+// Display Library for SPI e-paper panels from Dalian Good Display and boards from Waveshare.
+// Requires HW SPI and Adafruit_GFX. Caution: the e-paper panels require 3.3V supply AND data lines!
+//
+// Display Library based on Demo Example from Good Display: https://www.good-display.com/companyfile/32/
+//
+// Author: Jean-Marc Zingg
+//
+// Version: see library.properties
+//
+// Library: https://github.com/ZinggJM/GxEPD2
+//
+// GxEPD2_FakeAsyncSPI: host (PC) fake of a queued SPI backend, for checking asynchronous upload with GxEPD2_EPD.
+// a queued block is "sent" after completion_polls calls of pending(); its bytes are copied to wire only then,
+// so a staging buffer reused too early shows up as wrong data in wire; with spi given, they are also sent there,
+// e.g. to a GxEPD2_HostPanel, for comparison with the stream of synchronous upload.
+// events: "queue n", "queue full", "wait" (first of consecutive pending() calls with blocks queued), "done n".
+
+#ifndef _GxEPD2_FakeAsyncSPI_H_
+#define _GxEPD2_FakeAsyncSPI_H_
+
+#include <stdint.h>
+#include <deque>
+#include <vector>
+#include <string>
+#include <SPI.h>
+
+#include "../../src/GxEPD2_AsyncSPI.h"
+
+class GxEPD2_FakeAsyncSPI : public GxEPD2_AsyncSPI
+{
+  public:
+    GxEPD2_FakeAsyncSPI(uint8_t queue_depth = 2, uint16_t completion_polls = 3, SPIClass* spi = 0) :
+      max_pending(0), _queue_depth(queue_depth), _completion_polls(completion_polls), _polls(0), _spi(spi) {};
+    bool queue(const uint8_t* data, uint16_t n)
+    {
+      if (_queue.size() >= _queue_depth)
+      {
+        events.push_back("queue full");
+        return false;
+      }
+      _queue.push_back(Block{data, n});
+      if (_queue.size() > max_pending) max_pending = _queue.size();
+      events.push_back("queue " + std::to_string(n));
+      return true;
+    };
+    uint8_t pending()
+    {
+      if (!_queue.empty() && (events.empty() || (events.back() != "wait"))) events.push_back("wait");
+      if (!_queue.empty() && (++_polls >= _completion_polls))
+      {
+        _complete();
+      }
+      return _queue.size();
+    };
+    // blocks queued and not yet sent, without polling
+    size_t queued() const
+    {
+      return _queue.size();
+    };
+    // complete the oldest queued block, e.g. as progress in the background
+    void completeOne()
+    {
+      if (!_queue.empty()) _complete();
+    };
+    // complete all queued blocks at once, e.g. at the end of a test
+    void flush()
+    {
+      while (!_queue.empty()) _complete();
+    };
+    void clear()
+    {
+      flush();
+      wire.clear();
+      events.clear();
+      max_pending = 0;
+    };
+  public:
+    std::vector<uint8_t> wire; // bytes of completed blocks, in completion order
+    std::vector<std::string> events;
+    size_t max_pending;
+  private:
+    struct Block
+    {
+      const uint8_t* data;
+      uint16_t n;
+    };
+    void _complete()
+    {
+      Block& b = _queue.front();
+      wire.insert(wire.end(), b.data, b.data + b.n);
+      if (_spi) for (uint16_t i = 0; i < b.n; i++) _spi->transfer(b.data[i]);
+      events.push_back("done " + std::to_string(b.n));
+      _queue.pop_front();
+      _polls = 0;
+    };
+    std::deque<Block> _queue;
+    uint8_t _queue_depth;
+    uint16_t _completion_polls;
+    uint16_t _polls;
+    SPIClass* _spi;
+};
+
+#endif
@@ -0,0 +1,171 @@
+// Display Library for SPI e-paper panels from Dalian Good Display and boards from Waveshare.
+// Requires HW SPI and Adafruit_GFX. Caution: the e-paper panels require 3.3V supply AND data lines!
+//
+// Display Library based on Demo Example from Good Display: https://www.good-display.com/companyfile/32/
+//
+// Author: Jean-Marc Zingg
+//
+// Version: see library.properties
+//
+// Library: https://github.com/ZinggJM/GxEPD2
+//
+// GxEPD2_FullFrameTest: full frame buffers above 64 KB, for the largest panels;
+// paged drawing with the full frame as one page must write the same controller RAM content as with pages of 16 rows.
+// the streams differ by the RAM window commands of each page, so the data of the RAM write commands is compared,
+// concatenated per controller and command; the pages are rows, in the order of the controller's RAM.
+// exit code 0 if all checks pass.
+
+#include "GxEPD2_Host.h"
+#include <GxEPD2_BW.h>
+#include <GxEPD2_3C.h>
+#include <epd/GxEPD2_1160_T91.h>
+#include <epd/GxEPD2_1248.h>
+#include <epd3c/GxEPD2_1248c.h>
+#include <it8951/GxEPD2_it103_1872x1404.h>
+#include <algorithm>
+#include <map>
+
+static const int16_t CS = 5, DC = 17, RST = 16, BUSY = 4;
+static const int16_t CS_S1 = 25, CS_M2 = 26, CS_S2 = 27;
+static uint16_t failures = 0;
+
+static void check(bool ok, const char* what, const char* name)
+{
+  if (ok) return;
+  printf("FAIL %s, %s\n", what, name);
+  failures++;
+}
+
+// RAM write data, concatenated per controller and command
+typedef std::map<int32_t, std::vector<uint8_t>> Content;
+
+// frame, filled boxes in black and color, diagonals of single pixels; the lower part is above 64 KB of the full frame buffer
+template<typename Display> void drawContent(Display& display)
+{
+  int16_t w = display.width(), h = display.height();
+  display.fillScreen(GxEPD_WHITE);
+  display.fillRect(0, 0, w, 4, GxEPD_BLACK);
+  display.fillRect(0, h - 4, w, 4, GxEPD_BLACK);
+  display.fillRect(w / 8, h / 8, w / 4, h / 4, GxEPD_BLACK);
+  display.fillRect(w / 2, h / 2, w / 4, h / 4, GxEPD_RED);
+  for (int16_t i = 0; i < w && i < h; i++)
+  {
+    display.drawPixel(i, i, GxEPD_BLACK);
+    display.drawPixel(w - 1 - i, i, GxEPD_BLACK);
+  }
+}
+
+// data of the commands in write_commands, for controllers with DC
+static void ramWrites(const GxEPD2_HostPanel& panel, int32_t controller, const std::vector<int16_t>& write_commands, Content& content)
+{
+  for (const GxEPD2_HostPanel::Command& c : panel.commands)
+  {
+    if (std::find(write_commands.begin(), write_commands.end(), c.command) == write_commands.end()) continue;
+    std::vector<uint8_t>& v = content[(controller << 8) | c.command];
+    v.insert(v.end(), c.all_data.begin(), c.all_data.end());
+  }
+}
+
+// IT8951: each transaction is a record, starting with its preamble: 0x6000 command, 0x0000 data;
+// the image data is the data transaction after the arguments of IT8951_TCON_LD_IMG_AREA (0x0021)
+static void it8951ImageLoads(const GxEPD2_HostPanel& panel, Content& content)
+{
+  uint16_t command = 0;
+  uint16_t data_transactions = 0;
+  for (const GxEPD2_HostPanel::Command& c : panel.commands)
+  {
+    if (c.all_data.size() < 2) continue;
+    uint16_t preamble = (c.all_data[0] << 8) | c.all_data[1];
+    if ((0x6000 == preamble) && (c.all_data.size() >= 4))
+    {
+      command = (c.all_data[2] << 8) | c.all_data[3];
+      data_transactions = 0;
+    }
+    else if ((0x0000 == preamble) && (0x0021 == command) && (1 == data_transactions++))
+    {
+      std::vector<uint8_t>& v = content[command];
+      v.insert(v.end(), c.all_data.begin() + 2, c.all_data.end());
+    }
+  }
+}
+
+struct Panels
+{
+  std::vector<GxEPD2_HostPanel*> panels;
+  std::vector<int16_t> write_commands; // none: IT8951
+  ~Panels()
+  {
+    for (GxEPD2_HostPanel* p : panels) delete p;
+  }
+};
+
+template<typename Display> Content paged(Display& display, Panels& panels)
+{
+  GxEPD2_Host::reset();
+  display.init(0);
+  display.clearScreen(); // initial full refresh, not compared
+  for (GxEPD2_HostPanel* p : panels.panels)
+  {
+    p->keep_data = true;
+    p->clear();
+  }
+  display.setFullWindow();
+  display.firstPage();
+  do
+  {
+    drawContent(display);
+  }
+  while (display.nextPage());
+  display.hibernate();
+  Content content;
+  for (size_t i = 0; i < panels.panels.size(); i++)
+  {
+    if (panels.write_commands.empty()) it8951ImageLoads(*panels.panels[i], content);
+    else ramWrites(*panels.panels[i], i, panels.write_commands, content);
+  }
+  return content;
+}
+
+template<template<typename, const uint16_t, typename...> class GxEPD2_Template, typename GxEPD2_Type>
+void compare(const char* name, GxEPD2_Type driver, Panels& panels)
+{
+  typedef GxEPD2_Template<GxEPD2_Type, GxEPD2_Type::HEIGHT> FullFrame;
+  typedef GxEPD2_Template<GxEPD2_Type, 16> Rows16;
+  FullFrame* full_frame = new FullFrame(driver); // buffers can be large
+  Rows16* rows16 = new Rows16(driver);
+  check(1 == full_frame->pages(), "full frame buffer is not one page", name);
+  check(sizeof(*full_frame) > 65536, "full frame buffer not above 64 KB", name);
+  Content full_frame_content = paged(*full_frame, panels);
+  Content rows16_content = paged(*rows16, panels);
+  uint32_t bytes = 0;
+  for (const Content::value_type& v : full_frame_content) bytes += v.second.size();
+  check(bytes >= uint32_t(GxEPD2_Type::WIDTH / 8) * GxEPD2_Type::HEIGHT, "too few RAM write bytes", name);
+  check(full_frame_content == rows16_content, "full frame RAM content differs from 16 rows pages", name);
+  delete full_frame;
+  delete rows16;
+}
+
+int main()
+{
+  GxEPD2_Host::serial_output = false;
+  {
+    Panels panels;
+    panels.panels.push_back(new GxEPD2_HostPanel(CS, DC, RST, BUSY));
+    panels.write_commands = {0x24, 0x26};
+    compare<GxEPD2_BW>("GxEPD2_1160_T91", GxEPD2_1160_T91(CS, DC, RST, BUSY), panels);
+  }
+  {
+    Panels panels;
+    for (int16_t cs : {CS, CS_S1, CS_M2, CS_S2}) panels.panels.push_back(new GxEPD2_HostPanel(cs, DC, RST, BUSY));
+    panels.write_commands = {0x10, 0x13};
+    compare<GxEPD2_BW>("GxEPD2_1248", GxEPD2_1248(CS, CS_S1, CS_M2, CS_S2, DC, RST, BUSY), panels);
+    compare<GxEPD2_3C>("GxEPD2_1248c", GxEPD2_1248c(CS, CS_S1, CS_M2, CS_S2, DC, RST, BUSY), panels);
+  }
+  {
+    Panels panels;
+    panels.panels.push_back(new GxEPD2_HostPanel(CS, -1, RST, BUSY)); // no DC, transactions with preamble
+    compare<GxEPD2_BW>("GxEPD2_it103_1872x1404", GxEPD2_it103_1872x1404(CS, -1, RST, BUSY), panels);
+  }
+  printf("GxEPD2_FullFrameTest: %u failures\n", failures);
+  return failures ? 1 : 0;
+}
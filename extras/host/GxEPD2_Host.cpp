@@ -0,0 +1,317 @@
+// Display Library for SPI e-paper panels from Dalian Good Display and boards from Waveshare.
+// Requires HW SPI and Adafruit_GFX. Caution: the e-paper panels require 3.3V supply AND data lines!
+//
+// Display Library based on Demo Example from Good Display: https://www.good-display.com/companyfile/32/
+//
+// Author: Jean-Marc Zingg
+//
+// Version: see library.properties
+//
+// Library: https://github.com/ZinggJM/GxEPD2
+
+#include "GxEPD2_Host.h"
+
+#include <inttypes.h>
+#include <algorithm>
+
+HardwareSerial Serial;
+SPIClass SPI;
+
+uint32_t GxEPD2_Host::gpio_time_ns = 100;
+bool GxEPD2_Host::serial_output = true;
+void (*GxEPD2_Host::pin_callback)(int16_t pin, uint8_t value) = 0;
+uint64_t GxEPD2_Host::spi_bytes = 0;
+uint64_t GxEPD2_Host::spi_transactions = 0;
+
+struct GxEPD2_HostPin
+{
+  uint8_t level;
+  uint8_t mode;
+  bool busy_known;
+  uint8_t busy_level;
+  uint64_t busy_until; // ns
+};
+
+static const int16_t _host_pins = 256;
+static GxEPD2_HostPin _pins[_host_pins];
+static uint64_t _time_ns = 0;
+static std::vector<GxEPD2_HostPanel*> _panels;
+
+static const uint64_t fnv64_offset = 14695981039346656037ull;
+static const uint64_t fnv64_prime = 1099511628211ull;
+static const uint32_t fnv32_offset = 2166136261u;
+static const uint32_t fnv32_prime = 16777619u;
+
+static bool _valid(int16_t pin)
+{
+  return (pin >= 0) && (pin < _host_pins);
+}
+
+uint64_t GxEPD2_Host::now()
+{
+  return _time_ns / 1000;
+}
+
+uint64_t GxEPD2_Host::nowNs()
+{
+  return _time_ns;
+}
+
+void GxEPD2_Host::advance(uint64_t ns)
+{
+  _time_ns += ns;
+}
+
+void GxEPD2_Host::reset()
+{
+  _time_ns = 0;
+  memset(_pins, 0, sizeof(_pins));
+  spi_bytes = 0;
+  spi_transactions = 0;
+}
+
+void GxEPD2_Host::_pinWrite(int16_t pin, uint8_t value)
+{
+  if (!_valid(pin)) return;
+  uint8_t previous = _pins[pin].level;
+  _pins[pin].level = value ? HIGH : LOW;
+  if (previous && !value)
+  {
+    for (GxEPD2_HostPanel* p : _panels)
+    {
+      if (p->_rst == pin) p->_reset();
+      if ((p->_cs == pin) && !_valid(p->_dc)) p->_selected = true;
+    }
+  }
+}
+
+int GxEPD2_Host::_pinRead(int16_t pin)
+{
+  if (!_valid(pin)) return LOW;
+  GxEPD2_HostPin& p = _pins[pin];
+  if (p.busy_known) return (_time_ns < p.busy_until) ? p.busy_level : !p.busy_level;
+  if (p.mode == INPUT_PULLUP) return HIGH;
+  return p.level;
+}
+
+void GxEPD2_Host::_spiByte(const SPIClass* spi, uint8_t value, uint32_t clock)
+{
+  spi_bytes++;
+  _time_ns += 8000000000ull / (clock ? clock : 1);
+  for (GxEPD2_HostPanel* p : _panels)
+  {
+    if (p->bus && (p->bus != spi)) continue;
+    if ((p->_cs < 0) || (_valid(p->_cs) && (LOW == _pins[p->_cs].level))) p->_receive(value);
+  }
+}
+
+void GxEPD2_Host::_busyPhase(int16_t busy, int16_t busy_level, uint16_t busy_time)
+{
+  if (!_valid(busy)) return;
+  GxEPD2_HostPin& p = _pins[busy];
+  p.busy_known = true;
+  p.busy_level = busy_level ? HIGH : LOW;
+  p.busy_until = _time_ns + 1000000ull * busy_time;
+  for (GxEPD2_HostPanel* panel : _panels)
+  {
+    if (panel->_busy == busy) panel->_busyPhase(1000ul * busy_time);
+  }
+}
+
+GxEPD2_HostPanel::GxEPD2_HostPanel(int16_t cs, int16_t dc, int16_t rst, int16_t busy, const char* name) :
+  keep_data(false), bus(0), _cs(cs), _dc(dc), _rst(rst), _busy(busy), _name(name), _selected(false)
+{
+  clear();
+  _panels.push_back(this);
+}
+
+GxEPD2_HostPanel::~GxEPD2_HostPanel()
+{
+  _panels.erase(std::remove(_panels.begin(), _panels.end(), this), _panels.end());
+}
+
+void GxEPD2_HostPanel::clear()
+{
+  commands.clear();
+  busy_phases.clear();
+  data_bytes = 0;
+  resets = 0;
+  _hash = fnv64_offset;
+}
+
+uint64_t GxEPD2_HostPanel::busyTime() const
+{
+  uint64_t sum = 0;
+  for (const BusyPhase& b : busy_phases) sum += b.duration;
+  return sum;
+}
+
+void GxEPD2_HostPanel::printSummary(FILE* out) const
+{
+  fprintf(out, "%s: commands %u, data bytes %" PRIu64 ", resets %u, busy phases %u, busy %" PRIu64 " us, hash %016" PRIx64 "\n",
+          _name ? _name : "panel", unsigned(commands.size()), data_bytes, resets, unsigned(busy_phases.size()), busyTime(), _hash);
+}
+
+void GxEPD2_HostPanel::dump(FILE* out) const
+{
+  printSummary(out);
+  std::vector<BusyPhase>::const_iterator b = busy_phases.begin();
+  for (const Command& c : commands)
+  {
+    for (; (b != busy_phases.end()) && (b->start < c.time); b++)
+    {
+      fprintf(out, "%12" PRIu64 "  BUSY %u us\n", b->start, b->duration);
+    }
+    if (c.command < 0) fprintf(out, "%12" PRIu64 "  --  %6u :", c.time, c.data_count);
+    else fprintf(out, "%12" PRIu64 "  %02X  %6u :", c.time, c.command, c.data_count);
+    for (uint32_t i = 0; i < std::min(c.data_count, uint32_t(sizeof(c.data))); i++) fprintf(out, " %02X", c.data[i]);
+    if (c.data_count > sizeof(c.data)) fprintf(out, " ... %08X", c.data_hash);
+    fprintf(out, "\n");
+  }
+  for (; b != busy_phases.end(); b++)
+  {
+    fprintf(out, "%12" PRIu64 "  BUSY %u us\n", b->start, b->duration);
+  }
+}
+
+void GxEPD2_HostPanel::_receive(uint8_t value)
+{
+  bool is_command = _valid(_dc) && (LOW == _pins[_dc].level);
+  _hash = (_hash ^ (is_command ? 0x100u | value : value)) * fnv64_prime;
+  if (is_command || commands.empty() || _selected)
+  {
+    _selected = false;
+    Command c;
+    c.time = GxEPD2_Host::now();
+    c.command = is_command ? value : -1;
+    c.data_count = 0;
+    c.data_hash = fnv32_offset;
+    memset(c.data, 0, sizeof(c.data));
+    commands.push_back(c);
+    if (is_command) return;
+  }
+  Command& c = commands.back();
+  if (c.data_count < sizeof(c.data)) c.data[c.data_count] = value;
+  if (keep_data) c.all_data.push_back(value);
+  c.data_count++;
+  c.data_hash = (c.data_hash ^ value) * fnv32_prime;
+  data_bytes++;
+}
+
+void GxEPD2_HostPanel::_reset()
+{
+  resets++;
+  if (_valid(_busy)) _pins[_busy].busy_until = 0;
+}
+
+void GxEPD2_HostPanel::_busyPhase(uint32_t duration)
+{
+  if (!busy_phases.empty() && (busy_phases.back().start == GxEPD2_Host::now()))
+  {
+    // same BUSY pin for more controllers, e.g. GxEPD2_1248
+    busy_phases.back().duration = std::max(busy_phases.back().duration, duration);
+    return;
+  }
+  BusyPhase b;
+  b.start = GxEPD2_Host::now();
+  b.duration = duration;
+  busy_phases.push_back(b);
+}
+
+// Arduino API
+
+void pinMode(int16_t pin, uint8_t mode)
+{
+  GxEPD2_Host::advance(GxEPD2_Host::gpio_time_ns);
+  if (_valid(pin)) _pins[pin].mode = mode;
+}
+
+void digitalWrite(int16_t pin, uint8_t value)
+{
+  GxEPD2_Host::advance(GxEPD2_Host::gpio_time_ns);
+  GxEPD2_Host::_pinWrite(pin, value);
+  if (GxEPD2_Host::pin_callback) GxEPD2_Host::pin_callback(pin, value);
+}
+
+int digitalRead(int16_t pin)
+{
+  GxEPD2_Host::advance(GxEPD2_Host::gpio_time_ns);
+  return GxEPD2_Host::_pinRead(pin);
+}
+
+void delay(unsigned long ms)
+{
+  GxEPD2_Host::advance(1000000ull * ms);
+}
+
+void delayMicroseconds(unsigned int us)
+{
+  GxEPD2_Host::advance(1000ull * us);
+}
+
+unsigned long micros()
+{
+  return (unsigned long)GxEPD2_Host::now();
+}
+
+unsigned long millis()
+{
+  return (unsigned long)(GxEPD2_Host::now() / 1000);
+}
+
+void yield()
+{
+}
+
+void GxEPD2_HostBusyPhase(int16_t busy, int16_t busy_level, uint16_t busy_time)
+{
+  GxEPD2_Host::_busyPhase(busy, busy_level, busy_time);
+}
+
+size_t HardwareSerial::write(uint8_t c)
+{
+  if (GxEPD2_Host::serial_output) putchar(c);
+  return 1;
+}
+
+size_t Print::print(const String& s)
+{
+  return write(s.c_str());
+}
+
+// SPI
+
+void SPIClass::beginTransaction(SPISettings settings)
+{
+  _clock = settings._clock;
+  _in_transaction = true;
+  GxEPD2_Host::spi_transactions++;
+}
+
+void SPIClass::endTransaction()
+{
+  _in_transaction = false;
+}
+
+uint8_t SPIClass::transfer(uint8_t data)
+{
+  GxEPD2_Host::_spiByte(this, data, _clock);
+  return 0;
+}
+
+uint16_t SPIClass::transfer16(uint16_t data)
+{
+  GxEPD2_Host::_spiByte(this, data >> 8, _clock);
+  GxEPD2_Host::_spiByte(this, data & 0xFF, _clock);
+  return 0;
+}
+
+void SPIClass::transfer(void* buf, size_t count)
+{
+  uint8_t* p = (uint8_t*)buf;
+  for (size_t i = 0; i < count; i++)
+  {
+    GxEPD2_Host::_spiByte(this, p[i], _clock);
+    p[i] = 0;
+  }
+}
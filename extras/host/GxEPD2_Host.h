@@ -0,0 +1,99 @@
+// Display Library for SPI e-paper panels from Dalian Good Display and boards from Waveshare.
+// Requires HW SPI and Adafruit_GFX. Caution: the e-paper panels require 3.3V supply AND data lines!
+//
+// Display Library based on Demo Example from Good Display: https://www.good-display.com/companyfile/32/
+//
+// Author: Jean-Marc Zingg
+//
+// Version: see library.properties
+//
+// Library: https://github.com/ZinggJM/GxEPD2
+//
+// GxEPD2_Host: virtual clock and panel model for the host (PC) build of GxEPD2, see README.md
+//
+// time advances only by delay(), delayMicroseconds(), SPI transfers (8 clocks per byte at the transaction's clock)
+// and pin access; a run is deterministic and takes no real time.
+// BUSY of a pin is active for the busy_time of each _waitWhileBusy() call, i.e. the driver's *_time constants.
+
+#ifndef _GxEPD2_Host_H_
+#define _GxEPD2_Host_H_
+
+#include <Arduino.h>
+#include <SPI.h>
+#include <stdio.h>
+#include <vector>
+
+class GxEPD2_HostPanel
+{
+  public:
+    struct Command
+    {
+      uint64_t time; // µs of virtual time
+      int16_t command; // -1 : data without command
+      uint32_t data_count;
+      uint32_t data_hash; // FNV-1a of all data bytes of this command
+      uint8_t data[8]; // first data bytes
+      std::vector<uint8_t> all_data; // all data bytes, if keep_data
+    };
+    struct BusyPhase
+    {
+      uint64_t start; // µs of virtual time
+      uint32_t duration; // µs
+    };
+    // records the stream of a controller selected by cs (-1: always selected), command if dc is LOW;
+    // without dc (-1) each selection by cs starts a new record, e.g. for the preamble protocol of IT8951
+    GxEPD2_HostPanel(int16_t cs, int16_t dc, int16_t rst, int16_t busy, const char* name = 0);
+    ~GxEPD2_HostPanel();
+    void clear(); // clear recordings
+    uint64_t hash() const // FNV-1a of the stream, commands distinct from data
+    {
+      return _hash;
+    };
+    uint64_t busyTime() const; // µs, sum of busy phases
+    void printSummary(FILE* out = stdout) const;
+    void dump(FILE* out = stdout) const; // one line per command
+  public:
+    std::vector<Command> commands;
+    std::vector<BusyPhase> busy_phases;
+    uint64_t data_bytes;
+    uint32_t resets;
+    bool keep_data; // keep all data bytes of each command, for content checks, default false
+    const SPIClass* bus; // records only the bytes of this SPIClass instance, for panels on separate buses; default 0: all
+  private:
+    void _receive(uint8_t value);
+    void _reset();
+    void _busyPhase(uint32_t duration);
+    int16_t _cs, _dc, _rst, _busy;
+    const char* _name;
+    uint64_t _hash;
+    bool _selected; // new record at next byte, without dc
+    friend class GxEPD2_Host;
+};
+
+class GxEPD2_Host
+{
+  public:
+    static uint64_t now(); // µs of virtual time
+    static uint64_t nowNs();
+    static void advance(uint64_t ns);
+    // virtual time 0, pins and counters cleared; panels stay attached
+    static void reset();
+  public:
+    static uint32_t gpio_time_ns; // cost of pinMode(), digitalWrite(), digitalRead(), default 100
+    static bool serial_output; // Serial to stdout, default true
+    static void (*pin_callback)(int16_t pin, uint8_t value); // after each digitalWrite(), e.g. for progress of a fake DMA; default 0
+    static uint64_t spi_bytes, spi_transactions;
+  private:
+    static void _pinWrite(int16_t pin, uint8_t value);
+    static int _pinRead(int16_t pin);
+    static void _spiByte(const SPIClass* spi, uint8_t value, uint32_t clock);
+    static void _busyPhase(int16_t busy, int16_t busy_level, uint16_t busy_time);
+    friend class GxEPD2_HostPanel;
+    friend class SPIClass;
+    friend void pinMode(int16_t pin, uint8_t mode);
+    friend void digitalWrite(int16_t pin, uint8_t value);
+    friend int digitalRead(int16_t pin);
+    friend void GxEPD2_HostBusyPhase(int16_t busy, int16_t busy_level, uint16_t busy_time);
+};
+
+#endif
@@ -0,0 +1,36 @@
+// Display Library for SPI e-paper panels from Dalian Good Display and boards from Waveshare.
+// Requires HW SPI and Adafruit_GFX. Caution: the e-paper panels require 3.3V supply AND data lines!
+//
+// Display Library based on Demo Example from Good Display: https://www.good-display.com/companyfile/32/
+//
+// Author: Jean-Marc Zingg
+//
+// Version: see library.properties
+//
+// Library: https://github.com/ZinggJM/GxEPD2
+//
+// GxEPD2_HostExample: a driver on the host panel model, prints the recorded command stream and virtual times.
+
+#include "GxEPD2_Host.h"
+#include <epd/GxEPD2_290_T94.h>
+#include <inttypes.h>
+
+static uint8_t bitmap[GxEPD2_290_T94::WIDTH / 8 * GxEPD2_290_T94::HEIGHT];
+
+int main(int argc, char** argv)
+{
+  // pins as in the wiring examples for ESP32
+  GxEPD2_290_T94 epd(/*CS=*/ 5, /*DC=*/ 17, /*RST=*/ 16, /*BUSY=*/ 4);
+  GxEPD2_HostPanel panel(5, 17, 16, 4, "GxEPD2_290_T94");
+  for (uint16_t i = 0; i < sizeof(bitmap); i++) bitmap[i] = (i % 16) < 8 ? 0xFF : 0x00;
+  epd.init(115200);
+  uint64_t start = GxEPD2_Host::now();
+  epd.writeImage(bitmap, 0, 0, GxEPD2_290_T94::WIDTH, GxEPD2_290_T94::HEIGHT);
+  uint64_t written = GxEPD2_Host::now();
+  epd.refresh(false);
+  uint64_t refreshed = GxEPD2_Host::now();
+  epd.powerOff();
+  printf("writeImage %" PRIu64 " us, refresh %" PRIu64 " us, total %" PRIu64 " us\n", written - start, refreshed - written, GxEPD2_Host::now());
+  panel.dump();
+  return 0;
+}
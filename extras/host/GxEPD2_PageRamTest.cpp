@@ -0,0 +1,149 @@
+// Display Library for SPI e-paper panels from Dalian Good Display and boards from Waveshare.
+// Requires HW SPI and Adafruit_GFX. Caution: the e-paper panels require 3.3V supply AND data lines!
+//
+// Display Library based on Demo Example from Good Display: https://www.good-display.com/companyfile/32/
+//
+// Author: Jean-Marc Zingg
+//
+// Version: see library.properties
+//
+// Library: https://github.com/ZinggJM/GxEPD2
+//
+// GxEPD2_PageRamTest: the controller RAM content after paged updates of GxEPD2_BW, which skips the pages known to be
+// in controller memory; a model of the SSD16xx RAM (0x11, 0x44, 0x45, 0x4E, 0x4F, 0x24 current, 0x26 previous)
+// is driven by the stream of GxEPD2_290_T94, for a pseudo random sequence of full and partial updates and contents.
+// after a full update both RAMs must hold the image, after a partial update the current RAM.
+// exit code 0 if all checks pass.
+
+#include "GxEPD2_Host.h"
+#include <GxEPD2_BW.h>
+#include <epd/GxEPD2_290_T94.h>
+
+static const uint16_t WIDTH = GxEPD2_290_T94::WIDTH;
+static const uint16_t HEIGHT = GxEPD2_290_T94::HEIGHT;
+static uint16_t failures = 0;
+
+static void check(bool ok, const char* what, uint16_t step)
+{
+  if (ok) return;
+  printf("FAIL %s, step %u\n", what, step);
+  failures++;
+}
+
+class GxEPD2_SSD16xxRam
+{
+  public:
+    GxEPD2_SSD16xxRam() : entry_mode_ok(true), _xs(0), _xe(0), _ys(0), _ye(0), _x(0), _y(0)
+    {
+      memset(ram, 0, sizeof(ram));
+    }
+    // applies the RAM window and RAM write commands of the recorded stream
+    void apply(const GxEPD2_HostPanel& panel)
+    {
+      for (const GxEPD2_HostPanel::Command& c : panel.commands)
+      {
+        const std::vector<uint8_t>& d = c.all_data;
+        switch (c.command)
+        {
+          case 0x11:
+            if ((d.size() > 0) && (0x03 != d[0])) entry_mode_ok = false; // only x increase, y increase is modelled
+            break;
+          case 0x44:
+            if (d.size() < 2) break;
+            _xs = d[0];
+            _xe = d[1];
+            break;
+          case 0x45:
+            if (d.size() < 4) break;
+            _ys = d[0] | (d[1] << 8);
+            _ye = d[2] | (d[3] << 8);
+            break;
+          case 0x4E:
+            if (d.size() > 0) _x = d[0];
+            break;
+          case 0x4F:
+            if (d.size() > 1) _y = d[0] | (d[1] << 8);
+            break;
+          case 0x24:
+          case 0x26:
+            for (uint8_t value : d) _write(0x24 == c.command ? 0 : 1, value);
+            break;
+        }
+      }
+    }
+  public:
+    uint8_t ram[2][HEIGHT][WIDTH / 8]; // 0: current (0x24), 1: previous (0x26)
+    bool entry_mode_ok;
+  private:
+    void _write(uint8_t i, uint8_t value)
+    {
+      if ((_y < HEIGHT) && (_x < WIDTH / 8)) ram[i][_y][_x] = value;
+      if (++_x > _xe)
+      {
+        _x = _xs;
+        if (++_y > _ye) _y = _ys;
+      }
+    }
+    uint16_t _xs, _xe, _ys, _ye, _x, _y;
+};
+
+// content 0: empty, else a 40x40 black box at a byte boundary
+static void drawContent(GxEPD2_BW<GxEPD2_290_T94, 32>& display, uint16_t content)
+{
+  display.fillScreen(GxEPD_WHITE);
+  if (content) display.fillRect(8 * (content % 10), (content * 7) % (HEIGHT - 40), 40, 40, GxEPD_BLACK);
+}
+
+static bool holds(const uint8_t ram[HEIGHT][WIDTH / 8], uint16_t content)
+{
+  for (uint16_t y = 0; y < HEIGHT; y++)
+  {
+    for (uint16_t x = 0; x < WIDTH / 8; x++)
+    {
+      uint16_t bx = content % 10, by = (content * 7) % (HEIGHT - 40);
+      bool black = content && (x >= bx) && (x < bx + 5) && (y >= by) && (y < by + 40);
+      if (ram[y][x] != (black ? 0x00 : 0xFF)) return false;
+    }
+  }
+  return true;
+}
+
+int main()
+{
+  GxEPD2_Host::serial_output = false;
+  GxEPD2_Host::reset();
+  GxEPD2_HostPanel panel(5, 17, 16, 4);
+  panel.keep_data = true;
+  GxEPD2_SSD16xxRam* model = new GxEPD2_SSD16xxRam();
+  GxEPD2_BW<GxEPD2_290_T94, 32>* display = new GxEPD2_BW<GxEPD2_290_T94, 32>(GxEPD2_290_T94(5, 17, 16, 4));
+  display->init(0);
+  uint32_t random = 1;
+  for (uint16_t step = 0; step < 400; step++)
+  {
+    random = random * 1103515245u + 12345u;
+    bool partial = (random >> 16) & 1;
+    uint16_t content = ((random >> 20) & 3) ? 0 : 1 + ((random >> 8) & 0x3F); // mostly empty, pages are skipped
+    if (step < 3) // the sequence that left stale previous image RAM: full with box, partial empty, full empty
+    {
+      partial = (1 == step);
+      content = (0 == step) ? 1 : 0;
+    }
+    panel.clear();
+    if (partial) display->setPartialWindow(0, 0, display->width(), display->height());
+    else display->setFullWindow();
+    display->firstPage();
+    do
+    {
+      drawContent(*display, content);
+    }
+    while (display->nextPage());
+    model->apply(panel);
+    check(holds(model->ram[0], content), "current image RAM differs from content", step);
+    if (!partial) check(holds(model->ram[1], content), "previous image RAM differs from content after full update", step);
+  }
+  check(model->entry_mode_ok, "data entry mode not modelled", 0);
+  delete display;
+  delete model;
+  printf("GxEPD2_PageRamTest: %u failures\n", failures);
+  return failures ? 1 : 0;
+}
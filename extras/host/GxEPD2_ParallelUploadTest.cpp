@@ -0,0 +1,164 @@
+// Display Library for SPI e-paper panels from Dalian Good Display and boards from Waveshare.
+// Requires HW SPI and Adafruit_GFX. Caution: the e-paper panels require 3.3V supply AND data lines!
+//
+// Display Library based on Demo Example from Good Display: https://www.good-display.com/companyfile/32/
+//
+// Author: Jean-Marc Zingg
+//
+// Version: see library.properties
+//
+// Library: https://github.com/ZinggJM/GxEPD2
+//
+// GxEPD2_ParallelUploadTest: GxEPD2_1248 and GxEPD2_1248c with one SPI bus and one GxEPD2_FakeAsyncSPI per controller;
+// queued blocks are also sent at each pin change, as by DMA in the background; each controller must receive the stream
+// of synchronous upload on one bus, so a shared dc pin is never switched during the data phase of another controller,
+// and the uploads of controllers with different dc pins must overlap, i.e. blocks are sent at pin changes of others.
+// one backend for all controllers on one bus must give the same streams, without overlap.
+// exit code 0 if all checks pass.
+
+#include "GxEPD2_Host.h"
+#include "GxEPD2_FakeAsyncSPI.h"
+#include <epd/GxEPD2_1248.h>
+#include <epd3c/GxEPD2_1248c.h>
+
+static const int16_t CS_M1 = 5, CS_S1 = 25, CS_M2 = 26, CS_S2 = 27, DC1 = 17, DC2 = 21, RST = 16, BUSY = 4;
+static const uint16_t WIDTH = GxEPD2_1248::WIDTH;
+static const uint16_t HEIGHT = GxEPD2_1248::HEIGHT;
+static uint8_t black[WIDTH / 8 * HEIGHT], color[WIDTH / 8 * HEIGHT];
+static SPIClass buses[4];
+static GxEPD2_FakeAsyncSPI* background[4]; // progress at each pin change
+static uint32_t background_blocks;
+static uint16_t failures = 0;
+
+static void check(bool ok, const char* what, const char* name, uint16_t staging_size)
+{
+  if (ok) return;
+  printf("FAIL %s, %s, staging buffer %u\n", what, name, staging_size);
+  failures++;
+}
+
+static void backgroundProgress(int16_t pin, uint8_t value)
+{
+  for (uint8_t i = 0; i < 4; i++)
+  {
+    if (!background[i] || (0 == background[i]->queued())) continue;
+    background[i]->completeOne(); // the pins of the own controller don't change while its blocks are queued
+    background_blocks++;
+  }
+}
+
+struct Result
+{
+  uint64_t hash[4], data_bytes[4];
+  size_t commands[4];
+  uint32_t fill_blocks, image_blocks; // sent in the background during writeScreenBuffer(), the image writes
+  bool operator==(const Result& other) const
+  {
+    for (uint8_t i = 0; i < 4; i++)
+    {
+      if ((hash[i] != other.hash[i]) || (data_bytes[i] != other.data_bytes[i]) || (commands[i] != other.commands[i])) return false;
+    }
+    return true;
+  };
+};
+
+static void writeImages(GxEPD2_1248& epd)
+{
+  epd.writeImage(black, 0, 0, WIDTH, HEIGHT);
+  epd.writeImage(black, 600, 450, 120, 90, true, true, false); // on all four controllers, invert, mirror_y
+  epd.writeImagePartAgain(black, 16, 20, WIDTH, HEIGHT, 640, 480, 40, 30);
+}
+
+static void writeImages(GxEPD2_1248c& epd)
+{
+  epd.writeImage(black, color, 0, 0, WIDTH, HEIGHT);
+  epd.writeImage(black, color, 600, 450, 120, 90, true, true, false);
+  epd.writeImagePart(black, 16, 20, WIDTH, HEIGHT, 640, 480, 40, 30); // black only, color filled
+}
+
+// async: 0 synchronous, 1 one backend on one bus, 4 one backend and bus per controller
+template<typename GxEPD2_Type> Result upload(GxEPD2_FakeAsyncSPI* fakes, uint8_t async, uint8_t* staging_buffer, uint16_t staging_size)
+{
+  GxEPD2_Host::reset();
+  GxEPD2_Type epd(CS_M1, CS_S1, CS_M2, CS_S2, DC1, DC2, RST, RST, BUSY, BUSY, BUSY, BUSY);
+  const int16_t cs[] = {CS_M1, CS_S1, CS_M2, CS_S2}, dc[] = {DC1, DC1, DC2, DC2};
+  GxEPD2_HostPanel* panels[4];
+  for (uint8_t i = 0; i < 4; i++)
+  {
+    panels[i] = new GxEPD2_HostPanel(cs[i], dc[i], RST, BUSY);
+    if (4 == async) panels[i]->bus = &buses[i];
+  }
+  SPISettings spi_settings(4000000, MSBFIRST, SPI_MODE0);
+  if (4 == async)
+  {
+    epd.selectSPI(buses[0], buses[1], buses[2], buses[3], spi_settings);
+    epd.selectAsyncTransfer(&fakes[0], &fakes[1], &fakes[2], &fakes[3], staging_buffer, staging_size);
+  }
+  else epd.selectSPI(SPI, spi_settings);
+  if (1 == async) epd.selectAsyncTransfer(&fakes[0], staging_buffer, staging_size);
+  epd.init(0);
+  for (uint8_t i = 0; i < 4; i++) panels[i]->clear();
+  Result result;
+  background_blocks = 0;
+  epd.writeScreenBuffer(0x55); // fill
+  result.fill_blocks = background_blocks;
+  writeImages(epd);
+  result.image_blocks = background_blocks - result.fill_blocks;
+  epd.refresh(true); // commands to all controllers after the transfers
+  epd.writeImage(black, 0, 0, 8, 1); // single byte
+  epd.hibernate();
+  for (uint8_t i = 0; i < 4; i++)
+  {
+    result.hash[i] = panels[i]->hash();
+    result.data_bytes[i] = panels[i]->data_bytes;
+    result.commands[i] = panels[i]->commands.size();
+    delete panels[i];
+  }
+  return result;
+}
+
+template<typename GxEPD2_Type> void compare(const char* name)
+{
+  Result sync = upload<GxEPD2_Type>(0, 0, 0, 0);
+  const uint16_t staging_sizes[] = {8, 64, 1000, 8192};
+  static uint8_t staging_buffer[8192];
+  GxEPD2_Host::pin_callback = backgroundProgress;
+  for (uint16_t size : staging_sizes)
+  {
+    GxEPD2_FakeAsyncSPI fakes[4] =
+    {
+      GxEPD2_FakeAsyncSPI(2, 3, &buses[0]), GxEPD2_FakeAsyncSPI(2, 3, &buses[1]),
+      GxEPD2_FakeAsyncSPI(2, 3, &buses[2]), GxEPD2_FakeAsyncSPI(2, 3, &buses[3])
+    };
+    for (uint8_t i = 0; i < 4; i++) background[i] = &fakes[i];
+    Result parallel = upload<GxEPD2_Type>(fakes, 4, staging_buffer, size);
+    check(parallel == sync, "stream on separate buses differs from synchronous upload", name, size);
+    check(parallel.fill_blocks > 0, "no overlap of controllers with different dc pins, fill", name, size);
+    check(parallel.image_blocks > 0, "no overlap of controllers with different dc pins, image", name, size);
+    uint32_t wire_bytes = 0;
+    for (uint8_t i = 0; i < 4; i++) wire_bytes += fakes[i].wire.size();
+    check(wire_bytes >= 2 * uint32_t(WIDTH / 8) * HEIGHT, "too few bytes through the fakes", name, size);
+    GxEPD2_FakeAsyncSPI fake(2, 3, &SPI);
+    for (uint8_t i = 0; i < 4; i++) background[i] = i ? 0 : &fake;
+    Result single = upload<GxEPD2_Type>(&fake, 1, staging_buffer, size);
+    check(single == sync, "stream with one backend differs from synchronous upload", name, size);
+    check(0 == single.fill_blocks + single.image_blocks, "overlap of controllers on one bus", name, size);
+    check(fake.wire.size() >= 2 * uint32_t(WIDTH / 8) * HEIGHT, "too few bytes through the fake", name, size);
+    for (uint8_t i = 0; i < 4; i++) background[i] = 0;
+  }
+  GxEPD2_Host::pin_callback = 0;
+}
+
+int main()
+{
+  GxEPD2_Host::serial_output = false;
+  for (uint32_t i = 0; i < sizeof(black); i++)
+  {
+    black[i] = uint8_t(i * 37 + (i >> 8));
+    color[i] = uint8_t(i * 101 + (i >> 7));
+  }
+  compare<GxEPD2_1248>("GxEPD2_1248");
+  compare<GxEPD2_1248c>("GxEPD2_1248c");
+  printf("GxEPD2_ParallelUploadTest: %u failures\n", failures);
+  return failures ? 1 : 0;
+}
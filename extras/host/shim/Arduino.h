@@ -0,0 +1,136 @@
+// Display Library for SPI e-paper panels from Dalian Good Display and boards from Waveshare.
+// Requires HW SPI and Adafruit_GFX. Caution: the e-paper panels require 3.3V supply AND data lines!
+//
+// Display Library based on Demo Example from Good Display: https://www.good-display.com/companyfile/32/
+//
+// Author: Jean-Marc Zingg
+//
+// Version: see library.properties
+//
+// Library: https://github.com/ZinggJM/GxEPD2
+//
+// Arduino.h for the host (PC) build of GxEPD2: the subset of the Arduino API used by the library.
+// time is virtual, pins and SPI are connected to the panel model, see GxEPD2_Host.h
+
+#ifndef _GxEPD2_HOST_ARDUINO_H_
+#define _GxEPD2_HOST_ARDUINO_H_
+
+#include <stdint.h>
+#include <inttypes.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <algorithm>
+#include <string>
+
+#include "Print.h"
+
+#define ARDUINO 10819
+
+#define HIGH 0x1
+#define LOW  0x0
+
+#define INPUT 0x0
+#define OUTPUT 0x1
+#define INPUT_PULLUP 0x2
+#define INPUT_PULLDOWN 0x3
+
+#define LSBFIRST 0
+#define MSBFIRST 1
+
+#define PROGMEM
+#define PSTR(s) (s)
+#define F(s) (s)
+#define pgm_read_byte(addr) (*(const uint8_t*)(addr))
+#define pgm_read_word(addr) (*(const uint16_t*)(addr))
+#define pgm_read_dword(addr) (*(const uint32_t*)(addr))
+#define pgm_read_pointer(addr) (*(addr))
+
+typedef bool boolean;
+typedef uint8_t byte;
+
+using std::min;
+using std::max;
+
+void pinMode(int16_t pin, uint8_t mode);
+void digitalWrite(int16_t pin, uint8_t value);
+int digitalRead(int16_t pin);
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+unsigned long micros();
+unsigned long millis();
+void yield();
+
+class String
+{
+  public:
+    String(const char* s = "") : _s(s ? s : "") {};
+    String(char c) : _s(1, c) {};
+    String(int value, unsigned char base = DEC) : _s(_format(long(value), base)) {};
+    String(unsigned int value, unsigned char base = DEC) : _s(_format((unsigned long)value, base)) {};
+    String(long value, unsigned char base = DEC) : _s(_format(value, base)) {};
+    String(unsigned long value, unsigned char base = DEC) : _s(_format(value, base)) {};
+    String operator+(const String& rhs) const
+    {
+      String rv(*this);
+      rv._s += rhs._s;
+      return rv;
+    };
+    String& operator+=(const String& rhs)
+    {
+      _s += rhs._s;
+      return *this;
+    };
+    const char* c_str() const
+    {
+      return _s.c_str();
+    };
+    unsigned int length() const
+    {
+      return _s.length();
+    };
+  private:
+    static std::string _format(long value, unsigned char base)
+    {
+      if (value < 0) return "-" + _format((unsigned long)(-value), base);
+      return _format((unsigned long)value, base);
+    };
+    static std::string _format(unsigned long value, unsigned char base)
+    {
+      char buf[8 * sizeof(long) + 1];
+      char* p = &buf[sizeof(buf) - 1];
+      *p = 0;
+      do
+      {
+        uint8_t d = value % base;
+        *--p = d < 10 ? '0' + d : 'A' + d - 10;
+        value /= base;
+      }
+      while (value);
+      return p;
+    };
+    std::string _s;
+};
+
+class HardwareSerial : public Print
+{
+  public:
+    void begin(unsigned long baud) {};
+    void end() {};
+    void flush() {};
+    size_t write(uint8_t c);
+    using Print::write;
+    operator bool()
+    {
+      return true;
+    };
+};
+
+extern HardwareSerial Serial;
+
+// hook for the host panel model: BUSY becomes active for busy_time ms, see GxEPD2_Host.h
+#define GxEPD2_HOST 1
+void GxEPD2_HostBusyPhase(int16_t busy, int16_t busy_level, uint16_t busy_time);
+
+#endif
@@ -0,0 +1,105 @@
+// Display Library for SPI e-paper panels from Dalian Good Display and boards from Waveshare.
+// Requires HW SPI and Adafruit_GFX. Caution: the e-paper panels require 3.3V supply AND data lines!
+//
+// Display Library based on Demo Example from Good Display: https://www.good-display.com/companyfile/32/
+//
+// Author: Jean-Marc Zingg
+//
+// Version: see library.properties
+//
+// Library: https://github.com/ZinggJM/GxEPD2
+//
+// Print.h for the host (PC) build of GxEPD2, the part of the Arduino Print class used by the library and Adafruit_GFX
+
+#ifndef _GxEPD2_HOST_PRINT_H_
+#define _GxEPD2_HOST_PRINT_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+
+#define DEC 10
+#define HEX 16
+#define OCT 8
+#define BIN 2
+
+class String;
+
+class Print
+{
+  public:
+    virtual ~Print() {};
+    virtual size_t write(uint8_t) = 0;
+    virtual size_t write(const uint8_t* buffer, size_t size)
+    {
+      size_t n = 0;
+      while (size--) n += write(*buffer++);
+      return n;
+    };
+    size_t write(const char* str)
+    {
+      return str ? write((const uint8_t*)str, strlen(str)) : 0;
+    };
+    size_t print(const char* s)
+    {
+      return write(s);
+    };
+    size_t print(char c)
+    {
+      return write(uint8_t(c));
+    };
+    size_t print(const String& s);
+    size_t print(unsigned char value, int base = DEC)
+    {
+      return print((unsigned long)value, base);
+    };
+    size_t print(int value, int base = DEC)
+    {
+      return print(long(value), base);
+    };
+    size_t print(unsigned int value, int base = DEC)
+    {
+      return print((unsigned long)value, base);
+    };
+    size_t print(long value, int base = DEC)
+    {
+      if ((base == DEC) && (value < 0)) return print('-') + print((unsigned long)(-value), base);
+      return print((unsigned long)value, base);
+    };
+    size_t print(unsigned long value, int base = DEC)
+    {
+      char buf[8 * sizeof(long) + 1];
+      char* p = &buf[sizeof(buf) - 1];
+      *p = 0;
+      if (base < 2) base = DEC;
+      do
+      {
+        uint8_t d = value % base;
+        *--p = d < 10 ? '0' + d : 'A' + d - 10;
+        value /= base;
+      }
+      while (value);
+      return write(p);
+    };
+    size_t print(double value, int digits = 2)
+    {
+      char buf[32];
+      snprintf(buf, sizeof(buf), "%.*f", digits, value);
+      return write(buf);
+    };
+    size_t println()
+    {
+      return write("\r\n");
+    };
+    template <typename T> size_t println(T value)
+    {
+      return print(value) + println();
+    };
+    template <typename T> size_t println(T value, int format)
+    {
+      return print(value, format) + println();
+    };
+};
+
+#endif
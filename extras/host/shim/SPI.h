@@ -0,0 +1,60 @@
+// Display Library for SPI e-paper panels from Dalian Good Display and boards from Waveshare.
+// Requires HW SPI and Adafruit_GFX. Caution: the e-paper panels require 3.3V supply AND data lines!
+//
+// Display Library based on Demo Example from Good Display: https://www.good-display.com/companyfile/32/
+//
+// Author: Jean-Marc Zingg
+//
+// Version: see library.properties
+//
+// Library: https://github.com/ZinggJM/GxEPD2
+//
+// SPI.h for the host (PC) build of GxEPD2: bytes go to the panel model, each byte takes 8 clocks of virtual time.
+
+#ifndef _GxEPD2_HOST_SPI_H_
+#define _GxEPD2_HOST_SPI_H_
+
+#include <Arduino.h>
+
+#define SPI_MODE0 0x00
+#define SPI_MODE1 0x04
+#define SPI_MODE2 0x08
+#define SPI_MODE3 0x0C
+
+#define SCK 18
+#define MISO 19
+#define MOSI 23
+#define SS 5
+
+class SPISettings
+{
+  public:
+    SPISettings() : _clock(4000000), _bitOrder(MSBFIRST), _dataMode(SPI_MODE0) {};
+    SPISettings(uint32_t clock, uint8_t bitOrder, uint8_t dataMode) : _clock(clock), _bitOrder(bitOrder), _dataMode(dataMode) {};
+  private:
+    uint32_t _clock;
+    uint8_t _bitOrder;
+    uint8_t _dataMode;
+    friend class SPIClass;
+};
+
+class SPIClass
+{
+  public:
+    SPIClass() : _clock(4000000), _in_transaction(false) {};
+    void begin() {};
+    void begin(int8_t sck, int8_t miso, int8_t mosi, int8_t ss) {};
+    void end() {};
+    void beginTransaction(SPISettings settings);
+    void endTransaction();
+    uint8_t transfer(uint8_t data);
+    uint16_t transfer16(uint16_t data);
+    void transfer(void* buf, size_t count);
+  private:
+    uint32_t _clock;
+    bool _in_transaction;
+};
+
+extern SPIClass SPI;
+
+#endif
@@ -0,0 +1,8 @@
+// avr/pgmspace.h for the host (PC) build of GxEPD2, PROGMEM is plain memory, see ../Arduino.h
+
+#ifndef _GxEPD2_HOST_PGMSPACE_H_
+#define _GxEPD2_HOST_PGMSPACE_H_
+
+#include <Arduino.h>
+
+#endif
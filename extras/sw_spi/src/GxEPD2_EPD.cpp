@@ -271,6 +271,27 @@ void GxEPD2_EPD::_transfer(uint8_t value)
   _spi_write(value);
 }
 
+void GxEPD2_EPD::_transferRow(const uint8_t* data, uint32_t n, bool invert, bool pgm)
+{
+  for (uint32_t i = 0; i < n; i++)
+  {
+#if defined(__AVR) || defined(ESP8266) || defined(ESP32)
+    uint8_t d = pgm ? pgm_read_byte(&data[i]) : data[i];
+#else
+    uint8_t d = data[i];
+#endif
+    _spi_write(invert ? ~d : d);
+  }
+}
+
+void GxEPD2_EPD::_transferFill(uint8_t value, uint32_t n)
+{
+  for (uint32_t i = 0; i < n; i++)
+  {
+    _spi_write(value);
+  }
+}
+
 void GxEPD2_EPD::_endTransfer()
 {
   if (_cs >= 0) digitalWrite(_cs, HIGH);
@@ -39,6 +39,9 @@ class GxEPD2_EPD
     const bool hasColor;
     const bool hasPartialUpdate;
     const bool hasFastPartialUpdate;
+    // differential update: controller takes the new image as previous image on refresh (e.g. N2OCP, or single image buffer),
+    // writeImageAgain() and the second phase of paged drawing are not needed; drivers that do this declare it true
+    static const bool hasPreviousImageSync = false;
     // constructor
     GxEPD2_EPD(int16_t cs, int16_t dc, int16_t rst, int16_t busy, int16_t busy_level, uint32_t busy_timeout,
                uint16_t w, uint16_t h, GxEPD2::Panel p, bool c, bool pu, bool fpu);
@@ -103,6 +106,13 @@ class GxEPD2_EPD
       return (a > b ? a : b);
     };
     void selectSPI(SPIClass& spi, SPISettings spi_settings){};
+    // no asynchronous refresh with SW SPI, these refresh synchronously
+    void refreshAsync(bool partial_update_mode = false) {refresh(partial_update_mode);};
+    void refreshAsync(int16_t x, int16_t y, int16_t w, int16_t h) {refresh(x, y, w, h);};
+    void powerOffAsync() {powerOff();};
+    bool isBusy() {return false;};
+    bool poll() {return false;};
+    void awaitRefresh() {};
   protected:
     void _reset();
     void _writeDataPGM(const uint8_t* data, uint16_t n, int16_t fill_with_zeroes = 0);
@@ -111,6 +121,10 @@ class GxEPD2_EPD
     void _writeCommandDataPGM(const uint8_t* pCommandData, uint8_t datalen);
     void _startTransfer();
     void _transfer(uint8_t value); 
+    void _transferRow(const uint8_t* data, uint32_t n, bool invert = false, bool pgm = false);
+    void _transferFill(uint8_t value, uint32_t n);
+    void _awaitAsync(){}; // no asynchronous transfer or refresh with SW SPI
+    void _countBusy(const char* comment, uint32_t elapsed){}; // no statistics with SW SPI
     void _endTransfer();
     void _beginTransaction(const SPISettings& settings);
     void _spi_write(uint8_t data);
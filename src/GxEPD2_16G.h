@@ -0,0 +1,991 @@
+// Display Library for SPI e-paper panels from Dalian Good Display and boards from Waveshare.
+// Requires HW SPI and Adafruit_GFX. Caution: the e-paper panels require 3.3V supply AND data lines!
+//
+// Display Library based on Demo Example from Good Display: https://www.good-display.com/companyfile/32/
+//
+// Author: Jean-Marc Zingg
+//
+// Version: see library.properties
+//
+// Library: https://github.com/ZinggJM/GxEPD2
+
+#ifndef _GxEPD2_16G_H_
+#define _GxEPD2_16G_H_
+// uncomment next line to use class GFX of library GFX_Root instead of Adafruit_GFX
+//#include <GFX.h>
+
+#ifndef ENABLE_GxEPD2_GFX
+// default is off
+#define ENABLE_GxEPD2_GFX 0
+#endif
+
+#if ENABLE_GxEPD2_GFX
+#include "GxEPD2_GFX.h"
+#define GxEPD2_GFX_BASE_CLASS GxEPD2_GFX
+#elif defined(_GFX_H_)
+#define GxEPD2_GFX_BASE_CLASS GFX
+#else
+#include <Adafruit_GFX.h>
+#define GxEPD2_GFX_BASE_CLASS Adafruit_GFX
+#endif
+
+#include "GxEPD2_EPD.h"
+#include "GxEPD2_DisplayList.h"
+#include "GxEPD2_Buffer.h"
+#include "GxEPD2_BufferPool.h"
+
+// for __has_include see https://en.cppreference.com/w/cpp/preprocessor/include
+// see also https://gcc.gnu.org/onlinedocs/cpp/_005f_005fhas_005finclude.html
+// #if !defined(__has_include) || __has_include("epd/GxEPD2_102.h") is not portable!
+
+#if defined __has_include
+#  if __has_include("GxEPD2.h")
+#    // __has_include can be used
+#  else
+#    // __has_include doesn't work for us, include anyway
+#    undef __has_include
+#    define __has_include(x) true
+#  endif
+#else
+#  // no __has_include, include anyway
+#  define __has_include(x) true
+#endif
+
+#if __has_include("it8951/GxEPD2_it60.h")
+#include "it8951/GxEPD2_it60.h"
+#endif
+#if __has_include("it8951/GxEPD2_it60_1448x1072.h")
+#include "it8951/GxEPD2_it60_1448x1072.h"
+#endif
+#if __has_include("it8951/GxEPD2_it78_1872x1404.h")
+#include "it8951/GxEPD2_it78_1872x1404.h"
+#endif
+#if __has_include("it8951/GxEPD2_it103_1872x1404.h")
+#include "it8951/GxEPD2_it103_1872x1404.h"
+#endif
+
+// 16 grey levels, 4 bits per pixel, 2 pixels per byte, the first in the high nibble, 0x0 black to 0xF white, for the IT8951 driver classes;
+// colors are mapped to grey levels by their luminance, e.g. GxEPD_DARKGREY to 0x7, GxEPD_LIGHTGREY to 0xC
+template<typename GxEPD2_Type, const uint16_t page_height, typename GxEPD2_Buffer = GxEPD2_InternalBuffer>
+class GxEPD2_16G : public GxEPD2_GFX_BASE_CLASS
+{
+  public:
+    GxEPD2_Type epd2;
+    // bytes of the display buffer, see GxEPD2_Buffer.h
+    static const uint32_t buffer_size = (GxEPD2_Type::WIDTH / 2) * uint32_t(page_height);
+    // buffer: buffer_size bytes with GxEPD2_ExternalBuffer, unused else
+#if ENABLE_GxEPD2_GFX
+    GxEPD2_16G(GxEPD2_Type epd2_instance, uint8_t* buffer = 0) : GxEPD2_GFX_BASE_CLASS(epd2, GxEPD2_Type::WIDTH_VISIBLE, GxEPD2_Type::HEIGHT), epd2(epd2_instance)
+#else
+    GxEPD2_16G(GxEPD2_Type epd2_instance, uint8_t* buffer = 0) : GxEPD2_GFX_BASE_CLASS(GxEPD2_Type::WIDTH_VISIBLE, GxEPD2_Type::HEIGHT), epd2(epd2_instance)
+#endif
+    {
+      _pixel_buffer = GxEPD2_Buffer::external ? buffer : _buffer_storage.data();
+      _pool = 0;
+      _page_height = page_height;
+      _pages = (HEIGHT / _page_height) + ((HEIGHT % _page_height) > 0);
+      _mirror = false;
+      _using_partial_mode = false;
+      _current_page = 0;
+      _async_refresh = false;
+      _deferred_power_off = false;
+      _dl_recording = false;
+      _dl_replay = false;
+      _dl_nested = 0;
+      _filled = false;
+      _drawn_ys = INT16_MAX;
+      _drawn_ye = 0;
+      _clearDirty();
+      setFullWindow();
+    }
+
+    // with GxEPD2_ExternalBuffer: the buffer is borrowed from pool, see GxEPD2_BufferPool.h;
+    // a pool smaller than buffer_size gives a smaller page height, as with the buffer size below
+    GxEPD2_16G(GxEPD2_Type epd2_instance, GxEPD2_BufferPool& pool) : GxEPD2_16G(epd2_instance, pool.buffer(), pool.size())
+    {
+      static_assert(GxEPD2_Buffer::external, "GxEPD2_BufferPool needs GxEPD2_ExternalBuffer");
+      _pool = &pool;
+    }
+
+    // a static pool must hold buffer_size, see GxEPD2_BufferPoolSize
+    template<const uint32_t pool_size>
+    GxEPD2_16G(GxEPD2_Type epd2_instance, GxEPD2_StaticBufferPool<pool_size>& pool) : GxEPD2_16G(epd2_instance, static_cast<GxEPD2_BufferPool&>(pool))
+    {
+      static_assert(pool_size >= buffer_size, "GxEPD2_StaticBufferPool smaller than buffer_size of this display class");
+    }
+
+    // with GxEPD2_ExternalBuffer: buffer of size bytes, e.g. allocated at init, of at least one line: buffer_size / page_height;
+    // the page height is the largest that fits, at most page_height, see GxEPD2_pageHeight() in GxEPD2_Buffer.h;
+    // pages() is 0 if not even one line fits, e.g. size 0 after a failed malloc(), then nothing is displayed
+    GxEPD2_16G(GxEPD2_Type epd2_instance, uint8_t* buffer, uint32_t size) : GxEPD2_16G(epd2_instance, buffer)
+    {
+      static_assert(GxEPD2_Buffer::external, "a buffer size needs GxEPD2_ExternalBuffer");
+      _page_height = GxEPD2_pageHeight(GxEPD2_Type::HEIGHT, buffer_size / page_height, (size < buffer_size) ? size : buffer_size);
+      _pages = _page_height ? (HEIGHT / _page_height) + ((HEIGHT % _page_height) > 0) : 0;
+    }
+
+    ~GxEPD2_16G()
+    {
+      if (_pool) _pool->release(this);
+    }
+
+    uint16_t pages()
+    {
+      return _pages;
+    }
+
+    uint16_t pageHeight()
+    {
+      return _page_height;
+    }
+
+    bool mirror(bool m)
+    {
+      _swap_ (_mirror, m);
+      return m;
+    }
+
+    // optional display list for paged drawing (pages() > 1), buffer of size bytes, nullptr disables it:
+    // the drawing is recorded once and replayed for each page, instead of executing the drawing code for each page.
+    // firstPage()/nextPage(): the loop body is executed once, nextPage() does all pages; drawPaged(): drawCallback is called once.
+    // needs 8 bytes per page, and 11 bytes per pixel, 13 per line, 15 per rectangle, 21 per character (32 bit);
+    // if the buffer is too small, the drawing code is executed for each page, as without display list
+    void setDisplayList(uint8_t* buffer, uint32_t size)
+    {
+      _display_list.setBuffer(buffer, size);
+    }
+
+    void drawPixel(int16_t x, int16_t y, uint16_t color)
+    {
+      if (_dl_recording) return _dlRecord(GxEPD2_DisplayList::Pixel, x, y, 1, 1, color);
+      if ((x < 0) || (x >= width()) || (y < 0) || (y >= height())) return;
+      if (_mirror) x = width() - x - 1;
+      // check rotation, move pixel around if necessary
+      switch (getRotation())
+      {
+        case 1:
+          _swap_(x, y);
+          x = WIDTH - x - 1;
+          break;
+        case 2:
+          x = WIDTH - x - 1;
+          y = HEIGHT - y - 1;
+          break;
+        case 3:
+          _swap_(x, y);
+          y = HEIGHT - y - 1;
+          break;
+      }
+      // transpose partial window to 0,0
+      x -= _pw_x;
+      y -= _pw_y;
+      // clip to (partial) window
+      if ((x < 0) || (x >= int16_t(_pw_w)) || (y < 0) || (y >= int16_t(_pw_h))) return;
+      // adjust for current page
+      y -= _current_page * _page_height;
+      // check if in current page
+      if ((y < 0) || (y >= int16_t(_page_height))) return;
+      uint32_t i = x / 2 + uint32_t(y) * (_pw_w / 2);
+      _markDirty(x, y, x + 1, y + 1);
+      uint8_t pv = grey4(color);
+      if (x & 1) _pixel_buffer[i] = (_pixel_buffer[i] & 0xF0) | pv;
+      else _pixel_buffer[i] = (_pixel_buffer[i] & 0x0F) | (pv << 4);
+    }
+
+    void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color)
+    {
+      if (_dl_recording) return _dlRecord(GxEPD2_DisplayList::HLine, x, y, w, 1, color);
+      if (w < 0) // as GFXcanvas1
+      {
+        w = -w;
+        x -= w - 1;
+      }
+      _fillRect(x, y, w, 1, color);
+    }
+
+    void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color)
+    {
+      if (_dl_recording) return _dlRecord(GxEPD2_DisplayList::VLine, x, y, 1, h, color);
+      if (h < 0) // as GFXcanvas1
+      {
+        h = -h;
+        y -= h - 1;
+      }
+      _fillRect(x, y, 1, h, color);
+    }
+
+    void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color)
+    {
+      if (_dl_recording) return _dlRecord(GxEPD2_DisplayList::Rect, x, y, w, h, color);
+      _fillRect(x, y, w, h, color);
+    }
+
+    using GxEPD2_GFX_BASE_CLASS::write;
+    size_t write(uint8_t c)
+    {
+      if (!_dl_recording || _dl_nested) return GxEPD2_GFX_BASE_CLASS::write(c);
+      // record the character with the text state, write it for cursor advance and pages
+      GxEPD2_DisplayList::Character character;
+      _dlGetTextState(character);
+      character.c = c;
+      _dl_first_page = _pages;
+      _dl_last_page = 0;
+      _dl_nested++;
+      size_t rv = GxEPD2_GFX_BASE_CLASS::write(c);
+      _dl_nested--;
+      if (_dl_first_page <= _dl_last_page) _display_list.add(GxEPD2_DisplayList::Char, _dl_first_page, _dl_last_page, &character, sizeof(character));
+      return rv;
+    }
+
+    void init(uint32_t serial_diag_bitrate = 0) // = 0 : disabled
+    {
+      epd2.init(serial_diag_bitrate);
+      _using_partial_mode = false;
+      _current_page = 0;
+      setFullWindow();
+    }
+
+    // init method with additional parameters:
+    // initial false for re-init after processor deep sleep wake up, if display power supply was kept
+    // only relevant for b/w displays with fast partial update
+    // reset_duration = 20 is default; a value of 2 may help with "clever" reset circuit of newer boards from Waveshare
+    // pulldown_rst_mode true for alternate RST handling to avoid feeding 5V through RST pin
+    void init(uint32_t serial_diag_bitrate, bool initial, uint16_t reset_duration = 20, bool pulldown_rst_mode = false)
+    {
+      epd2.init(serial_diag_bitrate, initial, reset_duration, pulldown_rst_mode);
+      _using_partial_mode = false;
+      _current_page = 0;
+      setFullWindow();
+    }
+
+    // init method with additional parameters:
+    // SPIClass& spi: either SPI or alternate HW SPI channel
+    // SPISettings spi_settings: e.g. for higher SPI speed selection
+    void init(uint32_t serial_diag_bitrate, bool initial, uint16_t reset_duration, bool pulldown_rst_mode, SPIClass& spi, SPISettings spi_settings)
+    {
+      epd2.selectSPI(spi, spi_settings);
+      epd2.init(serial_diag_bitrate, initial, reset_duration, pulldown_rst_mode);
+      _using_partial_mode = false;
+      _current_page = 0;
+      setFullWindow();
+    }
+
+    // release SPI and control pins
+    void end() 
+    {
+      awaitRefresh();
+      epd2.end();
+    }
+
+    void fillScreen(uint16_t color)
+    {
+      if (_dl_recording) return _dlRecord(GxEPD2_DisplayList::Fill, 0, 0, width(), height(), color);
+      if (_pool && !_pool->acquire(this)) _filled = false; // drawn by other display objects since
+      uint8_t pv = grey4(color) * 0x11;
+      // the part of the buffer used by the window; only the rows drawn since, if filled with the same before
+      // and not drawn by other display objects, as an external buffer may be, unless from a pool
+      uint16_t row_bytes = _pw_w / 2;
+      int16_t ys = _drawn_ys, ye = _drawn_ye;
+      if (!_filled || (pv != _fill_data) || (GxEPD2_Buffer::external && !_pool))
+      {
+        ys = 0;
+        ye = _page_height;
+      }
+      if (ys < ye)
+      {
+        memset(_pixel_buffer + uint32_t(ys) * row_bytes, pv, uint32_t(ye - ys) * row_bytes);
+        _markDirty(0, ys, _pw_w, ye); // the rows not drawn since are unchanged, for displayChanged()
+      }
+      _filled = true;
+      _fill_data = pv;
+      _drawn_ys = INT16_MAX;
+      _drawn_ye = 0;
+    }
+
+    // display buffer content to screen, useful for full screen buffer
+    void display(bool partial_update_mode = false)
+    {
+      if (0 == _pages) return; // no buffer, see constructor with buffer size
+      awaitRefresh();
+      epd2.writeImage4bpp(_pixel_buffer, 0, 0, GxEPD2_Type::WIDTH, _page_height);
+      _refresh(partial_update_mode);
+      if (!partial_update_mode) _powerOff();
+      _clearDirty();
+    }
+
+    // display part of buffer content to screen, useful for full screen buffer
+    // displayWindow, use parameters according to actual rotation.
+    // x and w should be multiple of 4, for rotation 0 or 2,
+    // y and h should be multiple of 4, for rotation 1 or 3,
+    // else window is increased as needed,
+    // 4bpp loads of the IT8951 are in whole 16 bit words
+    void displayWindow(uint16_t x, uint16_t y, uint16_t w, uint16_t h)
+    {
+      if (0 == _pages) return; // no buffer, see constructor with buffer size
+      awaitRefresh();
+      x = gx_uint16_min(x, width());
+      y = gx_uint16_min(y, height());
+      w = gx_uint16_min(w, width() - x);
+      h = gx_uint16_min(h, height() - y);
+      _rotate(x, y, w, h);
+      w += x % 4;
+      if (w % 4 > 0) w += 4 - w % 4;
+      x -= x % 4;
+      epd2.writeImagePart4bpp(_pixel_buffer, x, y, GxEPD2_Type::WIDTH, _page_height, x, y, w, h);
+      _refresh(x, y, w, h);
+    }
+
+    // display the changed part of buffer content to screen, with partial refresh, useful for full screen buffer
+    // changes by drawing since the last display() or displayChanged() are tracked as a bounding box,
+    // increased to multiple of 4 in x direction of the controller; does nothing if unchanged;
+    // for full window and one page only, else does display(true)
+    void displayChanged()
+    {
+      if (0 == _pages) return; // no buffer, see constructor with buffer size
+      awaitRefresh();
+      if ((_dirty_xe <= _dirty_xs) || (_dirty_ye <= _dirty_ys)) return;
+      if (_using_partial_mode || (_pages > 1)) return display(true); // the bounding box is relative to window and page
+      uint16_t x = _dirty_xs - _dirty_xs % 4;
+      uint16_t y = _dirty_ys;
+      uint16_t w = gx_uint16_min(_dirty_xe + (4 - _dirty_xe % 4) % 4, GxEPD2_Type::WIDTH) - x;
+      uint16_t h = _dirty_ye - _dirty_ys;
+      _clearDirty();
+      epd2.writeImagePart4bpp(_pixel_buffer, x, y, GxEPD2_Type::WIDTH, _page_height, x, y, w, h);
+      _refresh(x, y, w, h);
+    }
+
+    // non-blocking variants of display(), displayWindow(), nextPage() and refresh():
+    // these return as soon as the refresh is started; the powerOff after the refresh
+    // is deferred and done by poll() or awaitRefresh().
+    void displayAsync(bool partial_update_mode = false)
+    {
+      _async_refresh = true;
+      display(partial_update_mode);
+      _async_refresh = false;
+    }
+
+    void displayWindowAsync(uint16_t x, uint16_t y, uint16_t w, uint16_t h)
+    {
+      _async_refresh = true;
+      displayWindow(x, y, w, h);
+      _async_refresh = false;
+    }
+
+    void displayChangedAsync()
+    {
+      _async_refresh = true;
+      displayChanged();
+      _async_refresh = false;
+    }
+
+    bool nextPageAsync()
+    {
+      _async_refresh = true;
+      bool rv = nextPage();
+      _async_refresh = false;
+      return rv;
+    }
+
+    // true while an asynchronous refresh or its deferred powerOff is not completed
+    bool isBusy()
+    {
+      return epd2.isBusy() || _deferred_power_off;
+    }
+
+    // does the deferred powerOff as soon as the panel is ready; returns true while busy, call from loop()
+    bool poll()
+    {
+      if (epd2.poll()) return true;
+      if (_deferred_power_off)
+      {
+        _deferred_power_off = false;
+        epd2.powerOffAsync();
+      }
+      return epd2.poll();
+    }
+
+    // waits for completion of an asynchronous refresh and its deferred powerOff
+    void awaitRefresh()
+    {
+      while (poll()) epd2.awaitRefresh();
+    }
+
+    void setFullWindow()
+    {
+      _using_partial_mode = false;
+      _pw_x = 0;
+      _pw_y = 0;
+      _pw_w = GxEPD2_Type::WIDTH;
+      _pw_h = HEIGHT;
+      _filled = false; // row length changed
+    }
+
+    // setPartialWindow, use parameters according to actual rotation.
+    // x and w should be multiple of 4, for rotation 0 or 2,
+    // y and h should be multiple of 4, for rotation 1 or 3,
+    // else window is increased as needed,
+    // 4bpp loads of the IT8951 are in whole 16 bit words
+    void setPartialWindow(uint16_t x, uint16_t y, uint16_t w, uint16_t h)
+    {
+      if (!epd2.hasPartialUpdate) return;
+      _pw_x = gx_uint16_min(x, width());
+      _pw_y = gx_uint16_min(y, height());
+      _pw_w = gx_uint16_min(w, width() - _pw_x);
+      _pw_h = gx_uint16_min(h, height() - _pw_y);
+      _rotate(_pw_x, _pw_y, _pw_w, _pw_h);
+      _using_partial_mode = true;
+      _filled = false; // row length changed
+      // make _pw_x, _pw_w multiple of 4
+      _pw_w += _pw_x % 4;
+      if (_pw_w % 4 > 0) _pw_w += 4 - _pw_w % 4;
+      _pw_x -= _pw_x % 4;
+    }
+
+    void firstPage()
+    {
+      if (0 == _pages) return; // no buffer, see constructor with buffer size
+      awaitRefresh();
+      fillScreen(GxEPD_WHITE);
+      _current_page = 0;
+      _dl_recording = _display_list.isEnabled() && (_pages > 1);
+      if (_dl_recording) _display_list.begin(_pages);
+    }
+
+    bool nextPage()
+    {
+      if (0 == _pages) return false; // no buffer, see constructor with buffer size
+      if (!_dl_recording) return _nextPage();
+      return _dlReplayPages();
+    }
+
+    // GxEPD style paged drawing; drawCallback() is called as many times as needed
+    void drawPaged(void (*drawCallback)(const void*), const void* pv)
+    {
+      if (0 == _pages) return; // no buffer, see constructor with buffer size
+      awaitRefresh();
+      if (_display_list.isEnabled() && (_pages > 1))
+      {
+        // record once, replay for each page, if it fits
+        _display_list.begin(_pages);
+        _dl_recording = true;
+        drawCallback(pv);
+        _dl_recording = false;
+        _dl_replay = !_display_list.overflow();
+        _dlGetTextState(_dl_text_state);
+      }
+      if (_using_partial_mode)
+      {
+        for (_current_page = 0; _current_page < _pages; _current_page++)
+        {
+          uint16_t page_ys = _current_page * _page_height;
+          uint16_t page_ye = _current_page < (_pages - 1) ? page_ys + _page_height : HEIGHT;
+          uint16_t dest_ys = _pw_y + page_ys; // transposed
+          uint16_t dest_ye = gx_uint16_min(_pw_y + _pw_h, _pw_y + page_ye);
+          if (dest_ye > dest_ys)
+          {
+            fillScreen(GxEPD_WHITE);
+            _drawPage(drawCallback, pv);
+            epd2.writeImage4bpp(_pixel_buffer, _pw_x, dest_ys, _pw_w, dest_ye - dest_ys);
+          }
+        }
+        epd2.refresh(_pw_x, _pw_y, _pw_w, _pw_h);
+      }
+      else // full update
+      {
+        for (_current_page = 0; _current_page < _pages; _current_page++)
+        {
+          uint16_t page_ys = _current_page * _page_height;
+          fillScreen(GxEPD_WHITE);
+          _drawPage(drawCallback, pv);
+          epd2.writeImage4bpp(_pixel_buffer, 0, page_ys, GxEPD2_Type::WIDTH, gx_uint16_min(_page_height, HEIGHT - page_ys));
+        }
+        epd2.refresh(false); // full update
+        epd2.powerOff();
+      }
+      _current_page = 0;
+      _clearDirty();
+      if (_dl_replay)
+      {
+        _dl_replay = false;
+        _dlSetTextState(_dl_text_state);
+      }
+    }
+
+    void drawInvertedBitmap(int16_t x, int16_t y, const uint8_t bitmap[], int16_t w, int16_t h, uint16_t color)
+    {
+      // taken from Adafruit_GFX.cpp, modified
+      int16_t byteWidth = (w + 7) / 8; // Bitmap scanline pad = whole byte
+      uint8_t byte = 0;
+      for (int16_t j = 0; j < h; j++)
+      {
+        for (int16_t i = 0; i < w; i++ )
+        {
+          if (i & 7) byte <<= 1;
+          else
+          {
+#if defined(__AVR) || defined(ESP8266) || defined(ESP32)
+            byte = pgm_read_byte(&bitmap[j * byteWidth + i / 8]);
+#else
+            byte = bitmap[j * byteWidth + i / 8];
+#endif
+          }
+          if (!(byte & 0x80))
+          {
+            drawPixel(x + i, y + j, color);
+          }
+        }
+      }
+    }
+
+    //  Support for Bitmaps (Sprites) to Controller Buffer and to Screen
+    void clearScreen(uint8_t value = 0xFF) // init controller memory and screen (default white)
+    {
+      awaitRefresh();
+      epd2.clearScreen(value);
+    }
+    void writeScreenBuffer(uint8_t value = 0xFF) // init controller memory (default white)
+    {
+      awaitRefresh();
+      epd2.writeScreenBuffer(value);
+    }
+    // write to controller memory, without screen refresh; x and w should be multiple of 8
+    void writeImage(const uint8_t bitmap[], int16_t x, int16_t y, int16_t w, int16_t h, bool invert = false, bool mirror_y = false, bool pgm = false)
+    {
+      epd2.writeImage(bitmap, x, y, w, h, invert, mirror_y, pgm);
+    }
+    void writeImagePart(const uint8_t bitmap[], int16_t x_part, int16_t y_part, int16_t w_bitmap, int16_t h_bitmap,
+                        int16_t x, int16_t y, int16_t w, int16_t h, bool invert = false, bool mirror_y = false, bool pgm = false)
+    {
+      epd2.writeImagePart(bitmap, x_part, y_part, w_bitmap, h_bitmap, x, y, w, h, invert, mirror_y, pgm);
+    }
+    void writeImage(const uint8_t* black, const uint8_t* color, int16_t x, int16_t y, int16_t w, int16_t h, bool invert, bool mirror_y, bool pgm)
+    {
+      epd2.writeImage(black, color, x, y, w, h, invert, mirror_y, pgm);
+    }
+    void writeImage(const uint8_t* black, const uint8_t* color, int16_t x, int16_t y, int16_t w, int16_t h)
+    {
+      epd2.writeImage(black, color, x, y, w, h, false, false, false);
+    }
+    void writeImagePart(const uint8_t* black, const uint8_t* color, int16_t x_part, int16_t y_part, int16_t w_bitmap, int16_t h_bitmap,
+                        int16_t x, int16_t y, int16_t w, int16_t h, bool invert, bool mirror_y, bool pgm)
+    {
+      epd2.writeImagePart(black, color, x_part, y_part, w_bitmap, h_bitmap, x, y, w, h, invert, mirror_y, pgm);
+    }
+    void writeImagePart(const uint8_t* black, const uint8_t* color, int16_t x_part, int16_t y_part, int16_t w_bitmap, int16_t h_bitmap,
+                        int16_t x, int16_t y, int16_t w, int16_t h)
+    {
+      epd2.writeImagePart(black, color, x_part, y_part, w_bitmap, h_bitmap, x, y, w, h, false, false, false);
+    }
+    // write sprite of native data to controller memory, without screen refresh; x and w should be multiple of 8
+    void writeNative(const uint8_t* data1, const uint8_t* data2, int16_t x, int16_t y, int16_t w, int16_t h, bool invert, bool mirror_y, bool pgm)
+    {
+      epd2.writeNative(data1, data2, x, y, w, h, invert, mirror_y, pgm);
+    }
+    // write 4bpp grey levels to controller memory, without screen refresh, in the format of the display buffer; x and w should be multiple of 4
+    void writeImage4bpp(const uint8_t bitmap[], int16_t x, int16_t y, int16_t w, int16_t h, bool invert = false, bool mirror_y = false, bool pgm = false)
+    {
+      epd2.writeImage4bpp(bitmap, x, y, w, h, invert, mirror_y, pgm);
+    }
+    void writeImagePart4bpp(const uint8_t bitmap[], int16_t x_part, int16_t y_part, int16_t w_bitmap, int16_t h_bitmap,
+                            int16_t x, int16_t y, int16_t w, int16_t h, bool invert = false, bool mirror_y = false, bool pgm = false)
+    {
+      epd2.writeImagePart4bpp(bitmap, x_part, y_part, w_bitmap, h_bitmap, x, y, w, h, invert, mirror_y, pgm);
+    }
+    // write to controller memory, with screen refresh; x and w should be multiple of 8
+    void drawImage(const uint8_t bitmap[], int16_t x, int16_t y, int16_t w, int16_t h, bool invert = false, bool mirror_y = false, bool pgm = false)
+    {
+      epd2.drawImage(bitmap, x, y, w, h, invert, mirror_y, pgm);
+    }
+    void drawImagePart(const uint8_t bitmap[], int16_t x_part, int16_t y_part, int16_t w_bitmap, int16_t h_bitmap,
+                       int16_t x, int16_t y, int16_t w, int16_t h, bool invert = false, bool mirror_y = false, bool pgm = false)
+    {
+      epd2.drawImagePart(bitmap, x_part, y_part, w_bitmap, h_bitmap, x, y, w, h, invert, mirror_y, pgm);
+    }
+    void drawImage(const uint8_t* black, const uint8_t* color, int16_t x, int16_t y, int16_t w, int16_t h, bool invert, bool mirror_y, bool pgm)
+    {
+      epd2.drawImage(black, color, x, y, w, h, invert, mirror_y, pgm);
+    }
+    void drawImage(const uint8_t* black, const uint8_t* color, int16_t x, int16_t y, int16_t w, int16_t h)
+    {
+      epd2.drawImage(black, color, x, y, w, h, false, false, false);
+    }
+    void drawImagePart(const uint8_t* black, const uint8_t* color, int16_t x_part, int16_t y_part, int16_t w_bitmap, int16_t h_bitmap,
+                       int16_t x, int16_t y, int16_t w, int16_t h, bool invert, bool mirror_y, bool pgm)
+    {
+      epd2.drawImagePart(black, color, x_part, y_part, w_bitmap, h_bitmap, x, y, w, h, invert, mirror_y, pgm);
+    }
+    void drawImagePart(const uint8_t* black, const uint8_t* color, int16_t x_part, int16_t y_part, int16_t w_bitmap, int16_t h_bitmap,
+                       int16_t x, int16_t y, int16_t w, int16_t h)
+    {
+      epd2.drawImagePart(black, color, x_part, y_part, w_bitmap, h_bitmap, x, y, w, h, false, false, false);
+    }
+    // write sprite of native data to controller memory, with screen refresh; x and w should be multiple of 8
+    void drawNative(const uint8_t* data1, const uint8_t* data2, int16_t x, int16_t y, int16_t w, int16_t h, bool invert, bool mirror_y, bool pgm)
+    {
+      epd2.drawNative(data1, data2, x, y, w, h, invert, mirror_y, pgm);
+    }
+    void refresh(bool partial_update_mode = false) // screen refresh from controller memory to full screen
+    {
+      awaitRefresh();
+      _refresh(partial_update_mode);
+      if (!partial_update_mode) _powerOff();
+    }
+    void refresh(int16_t x, int16_t y, int16_t w, int16_t h) // screen refresh from controller memory, partial screen
+    {
+      awaitRefresh();
+      _refresh(x, y, w, h);
+    }
+    // non-blocking refresh, see displayAsync()
+    void refreshAsync(bool partial_update_mode = false)
+    {
+      _async_refresh = true;
+      refresh(partial_update_mode);
+      _async_refresh = false;
+    }
+    void refreshAsync(int16_t x, int16_t y, int16_t w, int16_t h)
+    {
+      _async_refresh = true;
+      refresh(x, y, w, h);
+      _async_refresh = false;
+    }
+    // turns off generation of panel driving voltages, avoids screen fading over time
+    void powerOff()
+    {
+      awaitRefresh();
+      epd2.powerOff();
+    }
+    // turns powerOff() and sets controller to deep sleep for minimum power use, ONLY if wakeable by RST (rst >= 0)
+    void hibernate()
+    {
+      awaitRefresh();
+      epd2.hibernate();
+    }
+  private:
+    // paged drawing steps after drawing of a page
+    bool _nextPage()
+    {
+      uint16_t page_ys = _current_page * _page_height;
+      if (_using_partial_mode)
+      {
+        //Serial.print("  nextPage("); Serial.print(_pw_x); Serial.print(", "); Serial.print(_pw_y); Serial.print(", ");
+        //Serial.print(_pw_w); Serial.print(", "); Serial.print(_pw_h); Serial.print(") P"); Serial.println(_current_page);
+        uint16_t page_ye = _current_page < int16_t(_pages - 1) ? page_ys + _page_height : HEIGHT;
+        uint16_t dest_ys = _pw_y + page_ys; // transposed
+        uint16_t dest_ye = gx_uint16_min(_pw_y + _pw_h, _pw_y + page_ye);
+        if (dest_ye > dest_ys)
+        {
+          //Serial.print("writeImage("); Serial.print(_pw_x); Serial.print(", "); Serial.print(dest_ys); Serial.print(", ");
+          //Serial.print(_pw_w); Serial.print(", "); Serial.print(dest_ye - dest_ys); Serial.println(")");
+          epd2.writeImage4bpp(_pixel_buffer, _pw_x, dest_ys, _pw_w, dest_ye - dest_ys);
+        }
+        else
+        {
+          //Serial.print("writeImage("); Serial.print(_pw_x); Serial.print(", "); Serial.print(dest_ys); Serial.print(", ");
+          //Serial.print(_pw_w); Serial.print(", "); Serial.print(dest_ye - dest_ys); Serial.print(") skipped ");
+          //Serial.print(dest_ys); Serial.print(".."); Serial.println(dest_ye);
+        }
+        _current_page++;
+        if (_current_page == int16_t(_pages))
+        {
+          _current_page = 0;
+          _refresh(_pw_x, _pw_y, _pw_w, _pw_h); // single image buffer, no second phase
+          _clearDirty();
+          return false;
+        }
+        fillScreen(GxEPD_WHITE);
+        return true;
+      }
+      else // full update
+      {
+        epd2.writeImage4bpp(_pixel_buffer, 0, page_ys, GxEPD2_Type::WIDTH, gx_uint16_min(_page_height, HEIGHT - page_ys));
+        _current_page++;
+        if (_current_page == int16_t(_pages))
+        {
+          _current_page = 0;
+          _refresh(false); // full update
+          _powerOff();
+          _clearDirty();
+          return false;
+        }
+        fillScreen(GxEPD_WHITE);
+        return true;
+      }
+    }
+    template <typename T> static inline void
+    _swap_(T & a, T & b)
+    {
+      T t = a;
+      a = b;
+      b = t;
+    };
+    static inline uint16_t gx_uint16_min(uint16_t a, uint16_t b)
+    {
+      return (a < b ? a : b);
+    };
+    static inline uint16_t gx_uint16_max(uint16_t a, uint16_t b)
+    {
+      return (a > b ? a : b);
+    };
+    void _rotate(uint16_t& x, uint16_t& y, uint16_t& w, uint16_t& h)
+    {
+      switch (getRotation())
+      {
+        case 1:
+          _swap_(x, y);
+          _swap_(w, h);
+          x = WIDTH - x - w;
+          break;
+        case 2:
+          x = WIDTH - x - w;
+          y = HEIGHT - y - h;
+          break;
+        case 3:
+          _swap_(x, y);
+          _swap_(w, h);
+          y = HEIGHT - y - h;
+          break;
+      }
+    }
+    // rectangle in rotated coordinates: clipped once, then filled in whole bytes of the buffer
+    void _fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color)
+    {
+      if (x < 0)
+      {
+        w += x;
+        x = 0;
+      }
+      if (y < 0)
+      {
+        h += y;
+        y = 0;
+      }
+      if (w > width() - x) w = width() - x;
+      if (h > height() - y) h = height() - y;
+      if ((w <= 0) || (h <= 0)) return;
+      if (_mirror) x = width() - x - w;
+      uint16_t ux = x, uy = y, uw = w, uh = h;
+      _rotate(ux, uy, uw, uh);
+      // transpose partial window to 0,0
+      int16_t xs = int16_t(ux) - int16_t(_pw_x), xe = xs + int16_t(uw);
+      int16_t ys = int16_t(uy) - int16_t(_pw_y), ye = ys + int16_t(uh);
+      // clip to (partial) window
+      if (xs < 0) xs = 0;
+      if (ys < 0) ys = 0;
+      if (xe > int16_t(_pw_w)) xe = _pw_w;
+      if (ye > int16_t(_pw_h)) ye = _pw_h;
+      // adjust for current page, clip to it
+      int16_t page_ys = _current_page * _page_height;
+      ys = (ys > page_ys) ? ys - page_ys : 0;
+      ye = (ye - page_ys < int16_t(_page_height)) ? ye - page_ys : _page_height;
+      if ((xs >= xe) || (ys >= ye)) return;
+      _markDirty(xs, ys, xe, ye);
+      uint8_t data = grey4(color) * 0x11;
+      _fillBuffer(_pixel_buffer, data, xs, ys, xe, ye);
+    }
+    // pixels xs..xe-1 of rows ys..ye-1 set to data, masks for the partial bytes at the edges
+    void _fillBuffer(uint8_t* buffer, uint8_t data, int16_t xs, int16_t ys, int16_t xe, int16_t ye)
+    {
+      uint16_t row_bytes = _pw_w / 2;
+      uint16_t bs = xs / 2, be = (xe - 1) / 2;
+      uint8_t ms = (xs & 1) ? 0x0F : 0xFF;
+      uint8_t me = ((xe - 1) & 1) ? 0xFF : 0xF0;
+      if (bs == be) ms &= me;
+      for (int16_t y = ys; y < ye; y++)
+      {
+        uint8_t* p = buffer + uint32_t(y) * row_bytes + bs;
+        *p = (*p & ~ms) | (data & ms);
+        if (bs == be) continue;
+        if (be - bs > 1) memset(p + 1, data, be - bs - 1);
+        p[be - bs] = (p[be - bs] & ~me) | (data & me);
+      }
+    }
+    // refresh steps, deferred to poll() in asynchronous mode
+    void _refresh(bool partial_update_mode)
+    {
+      if (_async_refresh) epd2.refreshAsync(partial_update_mode);
+      else epd2.refresh(partial_update_mode);
+    }
+    void _refresh(int16_t x, int16_t y, int16_t w, int16_t h)
+    {
+      if (_async_refresh) epd2.refreshAsync(x, y, w, h);
+      else epd2.refresh(x, y, w, h);
+    }
+    void _powerOff()
+    {
+      if (_async_refresh) _deferred_power_off = true;
+      else epd2.powerOff();
+    }
+    // bounding box of changes in buffer coordinates, for displayChanged()
+    void _markDirty(int16_t xs, int16_t ys, int16_t xe, int16_t ye)
+    {
+      if (xs < _dirty_xs) _dirty_xs = xs;
+      if (ys < _dirty_ys) _dirty_ys = ys;
+      if (xe > _dirty_xe) _dirty_xe = xe;
+      if (ye > _dirty_ye) _dirty_ye = ye;
+      if (ys < _drawn_ys) _drawn_ys = ys;
+      if (ye > _drawn_ye) _drawn_ye = ye;
+    }
+    void _clearDirty()
+    {
+      _dirty_xs = _dirty_ys = INT16_MAX;
+      _dirty_xe = _dirty_ye = 0;
+    }
+    // grey level of the RGB565 color, by luminance 0.299 R + 0.587 G + 0.114 B
+    uint8_t grey4(uint16_t color)
+    {
+      static uint16_t _prev_color = GxEPD_BLACK;
+      static uint8_t _prev_grey4 = 0x00; // black
+      if (color == _prev_color) return _prev_grey4;
+      uint16_t red = ((color >> 11) & 0x1F) * 255 / 31;
+      uint16_t green = ((color >> 5) & 0x3F) * 255 / 63;
+      uint16_t blue = (color & 0x1F) * 255 / 31;
+      uint32_t luminance = 77ul * red + 150ul * green + 29ul * blue; // 8 bit weights, sum 256
+      _prev_color = color;
+      _prev_grey4 = luminance >> 12; // 16 levels of 8 bit
+      return _prev_grey4;
+    }
+    // display list: records a command with the pages it intersects; while writing a character, collects its pages
+    void _dlRecord(uint8_t command, int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color)
+    {
+      uint16_t first, last;
+      if (!_dlPageRange(x, y, w, h, first, last)) return;
+      if (_dl_nested)
+      {
+        _dl_first_page = gx_uint16_min(_dl_first_page, first);
+        _dl_last_page = gx_uint16_max(_dl_last_page, last);
+        return;
+      }
+      GxEPD2_DisplayList::Shape shape = {color, x, y, (command == GxEPD2_DisplayList::VLine) ? h : w, h};
+      _display_list.add(command, first, last, &shape, sizeof(shape));
+    }
+    // pages of a rectangle in rotated coordinates, as in drawPixel(); false if outside of (partial) window
+    bool _dlPageRange(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t& first, uint16_t& last)
+    {
+      int16_t x1 = x + w - 1, y1 = y + h - 1;
+      if (_mirror)
+      {
+        x = width() - x - 1;
+        x1 = width() - x1 - 1;
+      }
+      int16_t ys = y, ye = y1;
+      switch (getRotation())
+      {
+        case 1:
+          ys = x;
+          ye = x1;
+          break;
+        case 2:
+          ys = HEIGHT - y - 1;
+          ye = HEIGHT - y1 - 1;
+          break;
+        case 3:
+          ys = HEIGHT - x - 1;
+          ye = HEIGHT - x1 - 1;
+          break;
+      }
+      ys -= _pw_y;
+      ye -= _pw_y;
+      if (ys > ye) _swap_(ys, ye);
+      if ((ye < 0) || (ys >= int16_t(_pw_h))) return false;
+      first = (ys < 0) ? 0 : ys / _page_height;
+      last = ((ye < int16_t(_pw_h)) ? ye : _pw_h - 1) / _page_height;
+      return true;
+    }
+    // end of recording: all pages from the display list, or loop body for each page if it didn't fit
+    bool _dlReplayPages()
+    {
+      _dl_recording = false;
+      if (_display_list.overflow()) return true;
+      _dlGetTextState(_dl_text_state);
+      do
+      {
+        _dlReplay();
+      }
+      while (_nextPage());
+      _dlSetTextState(_dl_text_state);
+      return false;
+    }
+    // draws the commands of the display list that intersect the current page
+    void _dlReplay()
+    {
+      union
+      {
+        GxEPD2_DisplayList::Shape shape;
+        GxEPD2_DisplayList::Character character;
+      } data;
+      for (uint32_t i = _display_list.first(_current_page); i < _display_list.end(_current_page); i = _display_list.next(i))
+      {
+        switch (_display_list.get(i, _current_page, &data, sizeof(data)))
+        {
+          case GxEPD2_DisplayList::Pixel:
+            drawPixel(data.shape.x, data.shape.y, data.shape.color);
+            break;
+          case GxEPD2_DisplayList::HLine:
+            drawFastHLine(data.shape.x, data.shape.y, data.shape.w, data.shape.color);
+            break;
+          case GxEPD2_DisplayList::VLine:
+            drawFastVLine(data.shape.x, data.shape.y, data.shape.w, data.shape.color);
+            break;
+          case GxEPD2_DisplayList::Rect:
+            fillRect(data.shape.x, data.shape.y, data.shape.w, data.shape.h, data.shape.color);
+            break;
+          case GxEPD2_DisplayList::Fill:
+            fillScreen(data.shape.color);
+            break;
+          case GxEPD2_DisplayList::Char:
+            _dlSetTextState(data.character);
+            GxEPD2_GFX_BASE_CLASS::write(data.character.c);
+            break;
+        }
+      }
+    }
+    void _drawPage(void (*drawCallback)(const void*), const void* pv)
+    {
+      if (_dl_replay) _dlReplay();
+      else drawCallback(pv);
+    }
+    void _dlGetTextState(GxEPD2_DisplayList::Character& state)
+    {
+      state.font = gfxFont;
+      state.cursor_x = cursor_x;
+      state.cursor_y = cursor_y;
+      state.textcolor = textcolor;
+      state.textbgcolor = textbgcolor;
+      state.c = 0;
+      state.textsize_x = textsize_x;
+      state.textsize_y = textsize_y;
+      state.wrap = wrap;
+    }
+    void _dlSetTextState(const GxEPD2_DisplayList::Character& state)
+    {
+      gfxFont = (GFXfont*)state.font;
+      cursor_x = state.cursor_x;
+      cursor_y = state.cursor_y;
+      textcolor = state.textcolor;
+      textbgcolor = state.textbgcolor;
+      textsize_x = state.textsize_x;
+      textsize_y = state.textsize_y;
+      wrap = state.wrap;
+    }
+  private:
+    GxEPD2_BufferStorage<GxEPD2_Buffer::external, buffer_size> _buffer_storage;
+    GxEPD2_BufferPool* _pool;
+    uint8_t* _pixel_buffer;
+    bool _using_partial_mode, _mirror;
+    uint16_t _width_bytes, _pixel_bytes;
+    int16_t _current_page;
+    uint16_t _pages, _page_height;
+    uint16_t _pw_x, _pw_y, _pw_w, _pw_h;
+    bool _async_refresh, _deferred_power_off;
+    int16_t _dirty_xs, _dirty_ys, _dirty_xe, _dirty_ye;
+    bool _filled; // since fillScreen() with _fill_data, only rows _drawn_ys.._drawn_ye-1 were drawn
+    uint8_t _fill_data;
+    int16_t _drawn_ys, _drawn_ye;
+    GxEPD2_DisplayList _display_list;
+    bool _dl_recording, _dl_replay;
+    uint8_t _dl_nested;
+    uint16_t _dl_first_page, _dl_last_page;
+    GxEPD2_DisplayList::Character _dl_text_state;
+};
+
+#endif
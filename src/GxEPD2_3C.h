@@ -30,6 +30,11 @@
 #endif
 
 #include "GxEPD2_EPD.h"
+#include "GxEPD2_DisplayList.h"
+#include "GxEPD2_Buffer.h"
+#include "GxEPD2_BufferPool.h"
+#include "GxEPD2_Blit.h"
+#include "GxEPD2_GlyphCache.h"
 
 // for __has_include see https://en.cppreference.com/w/cpp/preprocessor/include
 // see also https://gcc.gnu.org/onlinedocs/cpp/_005f_005fhas_005finclude.html
@@ -118,25 +123,71 @@
 #include "gdem3c/GxEPD2_1330c_GDEM133Z91.h"
 #endif
 
-template<typename GxEPD2_Type, const uint16_t page_height>
+template<typename GxEPD2_Type, const uint16_t page_height, typename GxEPD2_Buffer = GxEPD2_InternalBuffer>
 class GxEPD2_3C : public GxEPD2_GFX_BASE_CLASS
 {
   public:
     GxEPD2_Type epd2;
+    // bytes of the display buffer, see GxEPD2_Buffer.h
+    static const uint32_t buffer_size = 2ul * (GxEPD2_Type::WIDTH / 8) * page_height;
+    // buffer: buffer_size bytes with GxEPD2_ExternalBuffer, unused else
 #if ENABLE_GxEPD2_GFX
-    GxEPD2_3C(GxEPD2_Type epd2_instance) : GxEPD2_GFX_BASE_CLASS(epd2, GxEPD2_Type::WIDTH_VISIBLE, GxEPD2_Type::HEIGHT), epd2(epd2_instance)
+    GxEPD2_3C(GxEPD2_Type epd2_instance, uint8_t* buffer = 0) : GxEPD2_GFX_BASE_CLASS(epd2, GxEPD2_Type::WIDTH_VISIBLE, GxEPD2_Type::HEIGHT), epd2(epd2_instance)
 #else
-    GxEPD2_3C(GxEPD2_Type epd2_instance) : GxEPD2_GFX_BASE_CLASS(GxEPD2_Type::WIDTH_VISIBLE, GxEPD2_Type::HEIGHT), epd2(epd2_instance)
+    GxEPD2_3C(GxEPD2_Type epd2_instance, uint8_t* buffer = 0) : GxEPD2_GFX_BASE_CLASS(GxEPD2_Type::WIDTH_VISIBLE, GxEPD2_Type::HEIGHT), epd2(epd2_instance)
 #endif
     {
+      _black_buffer = GxEPD2_Buffer::external ? buffer : _buffer_storage.data();
+      _pool = 0;
+      _color_buffer = _black_buffer + buffer_size / 2;
       _page_height = page_height;
       _pages = (HEIGHT / _page_height) + ((HEIGHT % _page_height) > 0);
       _mirror = false;
       _using_partial_mode = false;
       _current_page = 0;
+      _async_refresh = false;
+      _deferred_power_off = false;
+      _dl_recording = false;
+      _dl_replay = false;
+      _dl_nested = 0;
+      _filled = false;
+      _drawn_ys = INT16_MAX;
+      _drawn_ye = 0;
+      _clearDirty();
       setFullWindow();
     }
 
+    // with GxEPD2_ExternalBuffer: the buffer is borrowed from pool, see GxEPD2_BufferPool.h;
+    // a pool smaller than buffer_size gives a smaller page height, as with the buffer size below
+    GxEPD2_3C(GxEPD2_Type epd2_instance, GxEPD2_BufferPool& pool) : GxEPD2_3C(epd2_instance, pool.buffer(), pool.size())
+    {
+      static_assert(GxEPD2_Buffer::external, "GxEPD2_BufferPool needs GxEPD2_ExternalBuffer");
+      _pool = &pool;
+    }
+
+    // a static pool must hold buffer_size, see GxEPD2_BufferPoolSize
+    template<const uint32_t pool_size>
+    GxEPD2_3C(GxEPD2_Type epd2_instance, GxEPD2_StaticBufferPool<pool_size>& pool) : GxEPD2_3C(epd2_instance, static_cast<GxEPD2_BufferPool&>(pool))
+    {
+      static_assert(pool_size >= buffer_size, "GxEPD2_StaticBufferPool smaller than buffer_size of this display class");
+    }
+
+    // with GxEPD2_ExternalBuffer: buffer of size bytes, e.g. allocated at init, of at least one line: buffer_size / page_height;
+    // the page height is the largest that fits, at most page_height, see GxEPD2_pageHeight() in GxEPD2_Buffer.h;
+    // pages() is 0 if not even one line fits, e.g. size 0 after a failed malloc(), then nothing is displayed
+    GxEPD2_3C(GxEPD2_Type epd2_instance, uint8_t* buffer, uint32_t size) : GxEPD2_3C(epd2_instance, buffer)
+    {
+      static_assert(GxEPD2_Buffer::external, "a buffer size needs GxEPD2_ExternalBuffer");
+      _page_height = GxEPD2_pageHeight(GxEPD2_Type::HEIGHT, buffer_size / page_height, (size < buffer_size) ? size : buffer_size);
+      _pages = _page_height ? (HEIGHT / _page_height) + ((HEIGHT % _page_height) > 0) : 0;
+      _color_buffer = _black_buffer + (GxEPD2_Type::WIDTH / 8) * uint32_t(_page_height);
+    }
+
+    ~GxEPD2_3C()
+    {
+      if (_pool) _pool->release(this);
+    }
+
     uint16_t pages()
     {
       return _pages;
@@ -153,8 +204,27 @@ class GxEPD2_3C : public GxEPD2_GFX_BASE_CLASS
       return m;
     }
 
+    // optional display list for paged drawing (pages() > 1), buffer of size bytes, nullptr disables it:
+    // the drawing is recorded once and replayed for each page, instead of executing the drawing code for each page.
+    // firstPage()/nextPage(): the loop body is executed once, nextPage() does all pages; drawPaged(): drawCallback is called once.
+    // needs 8 bytes per page, and 11 bytes per pixel, 13 per line, 15 per rectangle, 21 per character (32 bit);
+    // if the buffer is too small, the drawing code is executed for each page, as without display list
+    void setDisplayList(uint8_t* buffer, uint32_t size)
+    {
+      _display_list.setBuffer(buffer, size);
+    }
+
+    // optional glyph cache for text with GFXfont: glyphs are expanded once, instead of for each character and page.
+    // needs (w + 7) / 8 * h + 3 bytes per glyph (5 with 32 bit pointers), and 128 bytes index;
+    // without it, glyphs are expanded in bands of a few rows, only those that intersect the current page
+    void setGlyphCache(uint8_t* buffer, uint16_t size)
+    {
+      _glyph_cache.setBuffer(buffer, size);
+    }
+
     void drawPixel(int16_t x, int16_t y, uint16_t color)
     {
+      if (_dl_recording) return _dlRecord(GxEPD2_DisplayList::Pixel, x, y, 1, 1, color);
       if ((x < 0) || (x >= width()) || (y < 0) || (y >= height())) return;
       if (_mirror) x = width() - x - 1;
       // check rotation, move pixel around if necessary
@@ -182,7 +252,8 @@ class GxEPD2_3C : public GxEPD2_GFX_BASE_CLASS
       y -= _current_page * _page_height;
       // check if in current page
       if ((y < 0) || (y >= int16_t(_page_height))) return;
-      uint16_t i = x / 8 + y * (_pw_w / 8);
+      uint32_t i = x / 8 + uint32_t(y) * (_pw_w / 8);
+      _markDirty(x, y, x + 1, y + 1);
       _black_buffer[i] = (_black_buffer[i] | (1 << (7 - x % 8))); // white
       _color_buffer[i] = (_color_buffer[i] | (1 << (7 - x % 8)));
       if (color == GxEPD_WHITE) return;
@@ -190,6 +261,52 @@ class GxEPD2_3C : public GxEPD2_GFX_BASE_CLASS
       else if ((color == GxEPD_RED) || (color == GxEPD_YELLOW)) _color_buffer[i] = (_color_buffer[i] & (0xFF ^ (1 << (7 - x % 8))));
     }
 
+    void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color)
+    {
+      if (_dl_recording) return _dlRecord(GxEPD2_DisplayList::HLine, x, y, w, 1, color);
+      if (w < 0) // as GFXcanvas1
+      {
+        w = -w;
+        x -= w - 1;
+      }
+      _fillRect(x, y, w, 1, color);
+    }
+
+    void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color)
+    {
+      if (_dl_recording) return _dlRecord(GxEPD2_DisplayList::VLine, x, y, 1, h, color);
+      if (h < 0) // as GFXcanvas1
+      {
+        h = -h;
+        y -= h - 1;
+      }
+      _fillRect(x, y, 1, h, color);
+    }
+
+    void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color)
+    {
+      if (_dl_recording) return _dlRecord(GxEPD2_DisplayList::Rect, x, y, w, h, color);
+      _fillRect(x, y, w, h, color);
+    }
+
+    using GxEPD2_GFX_BASE_CLASS::write;
+    size_t write(uint8_t c)
+    {
+      if (!_dl_recording) return _write(c);
+      if (_dl_nested) return GxEPD2_GFX_BASE_CLASS::write(c);
+      // record the character with the text state, write it for cursor advance and pages
+      GxEPD2_DisplayList::Character character;
+      _dlGetTextState(character);
+      character.c = c;
+      _dl_first_page = _pages;
+      _dl_last_page = 0;
+      _dl_nested++;
+      size_t rv = GxEPD2_GFX_BASE_CLASS::write(c);
+      _dl_nested--;
+      if (_dl_first_page <= _dl_last_page) _display_list.add(GxEPD2_DisplayList::Char, _dl_first_page, _dl_last_page, &character, sizeof(character));
+      return rv;
+    }
+
     void init(uint32_t serial_diag_bitrate = 0) // = 0 : disabled
     {
       epd2.init(serial_diag_bitrate);
@@ -226,29 +343,50 @@ class GxEPD2_3C : public GxEPD2_GFX_BASE_CLASS
     // release SPI and control pins
     void end() 
     {
+      awaitRefresh();
       epd2.end();
     }
 
     void fillScreen(uint16_t color) // 0x0 black, >0x0 white, to buffer
     {
+      if (_dl_recording) return _dlRecord(GxEPD2_DisplayList::Fill, 0, 0, width(), height(), color);
+      if (_pool && !_pool->acquire(this)) _filled = false; // drawn by other display objects since
       uint8_t black = 0xFF;
       uint8_t red = 0xFF;
       if (color == GxEPD_WHITE);
       else if (color == GxEPD_BLACK) black = 0x00;
       else if ((color == GxEPD_RED) || (color == GxEPD_YELLOW)) red = 0x00;
-      for (uint16_t x = 0; x < sizeof(_black_buffer); x++)
+      // the part of the buffers used by the window; only the rows drawn since, if filled with the same before
+      // and not drawn by other display objects, as an external buffer may be, unless from a pool
+      uint16_t row_bytes = _pw_w / 8;
+      int16_t ys = _drawn_ys, ye = _drawn_ye;
+      if (!_filled || (black != _fill_black) || (red != _fill_red) || (GxEPD2_Buffer::external && !_pool))
       {
-        _black_buffer[x] = black;
-        _color_buffer[x] = red;
+        ys = 0;
+        ye = _page_height;
       }
+      if (ys < ye)
+      {
+        memset(_black_buffer + uint32_t(ys) * row_bytes, black, uint32_t(ye - ys) * row_bytes);
+        memset(_color_buffer + uint32_t(ys) * row_bytes, red, uint32_t(ye - ys) * row_bytes);
+        _markDirty(0, ys, _pw_w, ye); // the rows not drawn since are unchanged, for displayChanged()
+      }
+      _filled = true;
+      _fill_black = black;
+      _fill_red = red;
+      _drawn_ys = INT16_MAX;
+      _drawn_ye = 0;
     }
 
     // display buffer content to screen, useful for full screen buffer
     void display(bool partial_update_mode = false)
     {
+      if (0 == _pages) return; // no buffer, see constructor with buffer size
+      awaitRefresh();
       epd2.writeImage(_black_buffer, _color_buffer, 0, 0, GxEPD2_Type::WIDTH, _page_height);
-      epd2.refresh(partial_update_mode);
-      if (!partial_update_mode) epd2.powerOff();
+      _refresh(partial_update_mode);
+      if (!partial_update_mode) _powerOff();
+      _clearDirty();
     }
 
     // display part of buffer content to screen, useful for full screen buffer
@@ -259,17 +397,96 @@ class GxEPD2_3C : public GxEPD2_GFX_BASE_CLASS
     // this is an addressing limitation of the e-paper controllers
     void displayWindow(uint16_t x, uint16_t y, uint16_t w, uint16_t h)
     {
+      if (0 == _pages) return; // no buffer, see constructor with buffer size
+      awaitRefresh();
       x = gx_uint16_min(x, width());
       y = gx_uint16_min(y, height());
       w = gx_uint16_min(w, width() - x);
       h = gx_uint16_min(h, height() - y);
       _rotate(x, y, w, h);
       epd2.writeImagePart(_black_buffer, _color_buffer, x, y, GxEPD2_Type::WIDTH, _page_height, x, y, w, h);
-      epd2.refresh(x, y, w, h);
+      _refresh(x, y, w, h);
+    }
+
+    // display the changed part of buffer content to screen, with partial refresh, useful for full screen buffer
+    // changes by drawing since the last display() or displayChanged() are tracked as a bounding box,
+    // increased to multiple of 8 in x direction of the controller; does nothing if unchanged;
+    // for full window and one page only, else does display(true)
+    void displayChanged()
+    {
+      if (0 == _pages) return; // no buffer, see constructor with buffer size
+      awaitRefresh();
+      if ((_dirty_xe <= _dirty_xs) || (_dirty_ye <= _dirty_ys)) return;
+      if (_using_partial_mode || (_pages > 1)) return display(true); // the bounding box is relative to window and page
+      uint16_t x = _dirty_xs - _dirty_xs % 8;
+      uint16_t y = _dirty_ys;
+      uint16_t w = gx_uint16_min(_dirty_xe + (8 - _dirty_xe % 8) % 8, GxEPD2_Type::WIDTH) - x;
+      uint16_t h = _dirty_ye - _dirty_ys;
+      _clearDirty();
+      epd2.writeImagePart(_black_buffer, _color_buffer, x, y, GxEPD2_Type::WIDTH, _page_height, x, y, w, h);
+      _refresh(x, y, w, h);
+    }
+
+    // non-blocking variants of display(), displayWindow(), nextPage() and refresh():
+    // these return as soon as the refresh is started; the powerOff after the refresh
+    // is deferred and done by poll() or awaitRefresh().
+    void displayAsync(bool partial_update_mode = false)
+    {
+      _async_refresh = true;
+      display(partial_update_mode);
+      _async_refresh = false;
+    }
+
+    void displayWindowAsync(uint16_t x, uint16_t y, uint16_t w, uint16_t h)
+    {
+      _async_refresh = true;
+      displayWindow(x, y, w, h);
+      _async_refresh = false;
+    }
+
+    void displayChangedAsync()
+    {
+      _async_refresh = true;
+      displayChanged();
+      _async_refresh = false;
+    }
+
+    bool nextPageAsync()
+    {
+      _async_refresh = true;
+      bool rv = nextPage();
+      _async_refresh = false;
+      return rv;
+    }
+
+    // true while an asynchronous refresh or its deferred powerOff is not completed
+    bool isBusy()
+    {
+      return epd2.isBusy() || _deferred_power_off;
+    }
+
+    // does the deferred powerOff as soon as the panel is ready; returns true while busy, call from loop()
+    bool poll()
+    {
+      if (epd2.poll()) return true;
+      if (_deferred_power_off)
+      {
+        _deferred_power_off = false;
+        epd2.powerOffAsync();
+      }
+      return epd2.poll();
+    }
+
+    // waits for completion of an asynchronous refresh and its deferred powerOff
+    void awaitRefresh()
+    {
+      while (poll()) epd2.awaitRefresh();
     }
 
     void displayWindowBW(uint16_t x, uint16_t y, uint16_t w, uint16_t h)
     {
+      if (0 == _pages) return; // no buffer, see constructor with buffer size
+      awaitRefresh();
       x = gx_uint16_min(x, width());
       y = gx_uint16_min(y, height());
       w = gx_uint16_min(w, width() - x);
@@ -287,6 +504,7 @@ class GxEPD2_3C : public GxEPD2_GFX_BASE_CLASS
       _pw_y = 0;
       _pw_w = GxEPD2_Type::WIDTH;
       _pw_h = HEIGHT;
+      _filled = false; // row length changed
     }
 
     // setPartialWindow, use parameters according to actual rotation.
@@ -303,6 +521,7 @@ class GxEPD2_3C : public GxEPD2_GFX_BASE_CLASS
       _pw_h = gx_uint16_min(h, height() - _pw_y);
       _rotate(_pw_x, _pw_y, _pw_w, _pw_h);
       _using_partial_mode = true;
+      _filled = false; // row length changed
       // make _pw_x, _pw_w multiple of 8
       _pw_w += _pw_x % 8;
       if (_pw_w % 8 > 0) _pw_w += 8 - _pw_w % 8;
@@ -311,160 +530,55 @@ class GxEPD2_3C : public GxEPD2_GFX_BASE_CLASS
 
     void firstPage()
     {
+      if (0 == _pages) return; // no buffer, see constructor with buffer size
+      awaitRefresh();
       fillScreen(GxEPD_WHITE);
       _current_page = 0;
       _second_phase = false;
       epd2.setPaged(); // for GxEPD2_154c paged workaround
+      _dl_recording = _display_list.isEnabled() && (_pages > 1);
+      if (_dl_recording) _display_list.begin(_pages);
     }
 
     bool nextPage()
     {
-      uint16_t page_ys = _current_page * _page_height;
-      if (_using_partial_mode)
-      {
-        //Serial.print("  nextPage("); Serial.print(_pw_x); Serial.print(", "); Serial.print(_pw_y); Serial.print(", ");
-        //Serial.print(_pw_w); Serial.print(", "); Serial.print(_pw_h); Serial.print(") P"); Serial.println(_current_page);
-        uint16_t page_ye = _current_page < int16_t(_pages - 1) ? page_ys + _page_height : HEIGHT;
-        uint16_t dest_ys = _pw_y + page_ys; // transposed
-        uint16_t dest_ye = gx_uint16_min(_pw_y + _pw_h, _pw_y + page_ye);
-        if (dest_ye > dest_ys)
-        {
-          //Serial.print("writeImage("); Serial.print(_pw_x); Serial.print(", "); Serial.print(dest_ys); Serial.print(", ");
-          //Serial.print(_pw_w); Serial.print(", "); Serial.print(dest_ye - dest_ys); Serial.println(")");
-          epd2.writeImage(_black_buffer, _color_buffer, _pw_x, dest_ys, _pw_w, dest_ye - dest_ys);
-        }
-        else
-        {
-          //Serial.print("writeImage("); Serial.print(_pw_x); Serial.print(", "); Serial.print(dest_ys); Serial.print(", ");
-          //Serial.print(_pw_w); Serial.print(", "); Serial.print(dest_ye - dest_ys); Serial.print(") skipped ");
-          //Serial.print(dest_ys); Serial.print(".."); Serial.println(dest_ye);
-        }
-        _current_page++;
-        if (_current_page == int16_t(_pages))
-        {
-          _current_page = 0;
-          if (!_second_phase)
-          {
-            epd2.refresh(_pw_x, _pw_y, _pw_w, _pw_h);
-            if (epd2.hasFastPartialUpdate)
-            {
-              _second_phase = true;
-              return true;
-            }
-          }
-          return false;
-        }
-        fillScreen(GxEPD_WHITE);
-        return true;
-      }
-      else // full update
-      {
-        epd2.writeImage(_black_buffer, _color_buffer, 0, page_ys, GxEPD2_Type::WIDTH, gx_uint16_min(_page_height, HEIGHT - page_ys));
-        _current_page++;
-        if (_current_page == int16_t(_pages))
-        {
-          _current_page = 0;
-          if ((epd2.panel == GxEPD2::GDEW0154Z04) && (_pages > 1))
-          {
-            if (!_second_phase)
-            {
-              epd2.refresh(false); // full update after first phase
-              _second_phase = true;
-              fillScreen(GxEPD_WHITE);
-              return true;
-            }
-            else epd2.refresh(true); // partial update after second phase
-          } else epd2.refresh(false); // full update after only phase
-          epd2.powerOff();
-          return false;
-        }
-        fillScreen(GxEPD_WHITE);
-        return true;
-      }
+      if (0 == _pages) return false; // no buffer, see constructor with buffer size
+      if (!_dl_recording) return _nextPage();
+      return _dlReplayPages();
     }
 
     bool nextPageBW()
     {
-      if (1 == _pages)
+      if (0 == _pages) return false; // no buffer, see constructor with buffer size
+      if (!_dl_recording) return _nextPageBW();
+      // as _dlReplayPages(), with _nextPageBW()
+      _dl_recording = false;
+      if (_display_list.overflow()) return true;
+      _dlGetTextState(_dl_text_state);
+      do
       {
-        if (_using_partial_mode)
-        {
-          epd2.writeImageNew(_black_buffer, _pw_x, _pw_y, _pw_w, _pw_h);
-          epd2.refresh_bw(_pw_x, _pw_y, _pw_w, _pw_h);
-          epd2.writeImagePrevious(_black_buffer, _pw_x, _pw_y, _pw_w, _pw_h);
-        }
-        else // full update
-        {
-          epd2.writeImage(_black_buffer, 0, 0, GxEPD2_Type::WIDTH, HEIGHT);
-          epd2.refresh(false);
-          epd2.writeImagePrevious(_black_buffer, 0, 0, GxEPD2_Type::WIDTH, HEIGHT);
-          epd2.powerOff();
-        }
-        return false;
-      }
-      uint16_t page_ys = _current_page * _page_height;
-      if (_using_partial_mode)
-      {
-        //Serial.print("  nextPage("); Serial.print(_pw_x); Serial.print(", "); Serial.print(_pw_y); Serial.print(", ");
-        //Serial.print(_pw_w); Serial.print(", "); Serial.print(_pw_h); Serial.print(") P"); Serial.println(_current_page);
-        uint16_t page_ye = _current_page < (_pages - 1) ? page_ys + _page_height : HEIGHT;
-        uint16_t dest_ys = _pw_y + page_ys; // transposed
-        uint16_t dest_ye = gx_uint16_min(_pw_y + _pw_h, _pw_y + page_ye);
-        if (dest_ye > dest_ys)
-        {
-          //Serial.print("writeImage("); Serial.print(_pw_x); Serial.print(", "); Serial.print(dest_ys); Serial.print(", ");
-          //Serial.print(_pw_w); Serial.print(", "); Serial.print(dest_ye - dest_ys); Serial.println(")");
-          if (!_second_phase) epd2.writeImageNew(_black_buffer, _pw_x, dest_ys, _pw_w, dest_ye - dest_ys);
-          else epd2.writeImagePrevious(_black_buffer, _pw_x, dest_ys, _pw_w, dest_ye - dest_ys);
-        }
-        else
-        {
-          //Serial.print("writeImage("); Serial.print(_pw_x); Serial.print(", "); Serial.print(dest_ys); Serial.print(", ");
-          //Serial.print(_pw_w); Serial.print(", "); Serial.print(dest_ye - dest_ys); Serial.print(") skipped ");
-          //Serial.print(dest_ys); Serial.print(".."); Serial.println(dest_ye);
-        }
-        _current_page++;
-        if (_current_page == _pages)
-        {
-          _current_page = 0;
-          if (!_second_phase)
-          {
-            epd2.refresh_bw(_pw_x, _pw_y, _pw_w, _pw_h);
-            _second_phase = true;
-            fillScreen(GxEPD_WHITE);
-            return true;
-          }
-          return false;
-        }
-        fillScreen(GxEPD_WHITE);
-        return true;
-      }
-      else // full update
-      {
-        if (!_second_phase) epd2.writeImage(_black_buffer, 0, page_ys, GxEPD2_Type::WIDTH, gx_uint16_min(_page_height, HEIGHT - page_ys));
-        else epd2.writeImagePrevious(_black_buffer, 0, page_ys, GxEPD2_Type::WIDTH, gx_uint16_min(_page_height, HEIGHT - page_ys));
-        _current_page++;
-        if (_current_page == _pages)
-        {
-          _current_page = 0;
-          if (!_second_phase)
-          {
-            epd2.refresh(false); // full update after first phase
-            _second_phase = true;
-            fillScreen(GxEPD_WHITE);
-            return true;
-          }
-          epd2.powerOff();
-          return false;
-        }
-        fillScreen(GxEPD_WHITE);
-        return true;
+        _dlReplay();
       }
+      while (_nextPageBW());
+      _dlSetTextState(_dl_text_state);
+      return false;
     }
 
     // GxEPD style paged drawing; drawCallback() is called as many times as needed
     void drawPaged(void (*drawCallback)(const void*), const void* pv)
     {
+      if (0 == _pages) return; // no buffer, see constructor with buffer size
+      awaitRefresh();
+      if (_display_list.isEnabled() && (_pages > 1))
+      {
+        // record once, replay for each page, if it fits
+        _display_list.begin(_pages);
+        _dl_recording = true;
+        drawCallback(pv);
+        _dl_recording = false;
+        _dl_replay = !_display_list.overflow();
+        _dlGetTextState(_dl_text_state);
+      }
       if (_using_partial_mode)
       {
         for (_current_page = 0; _current_page < _pages; _current_page++)
@@ -476,7 +590,7 @@ class GxEPD2_3C : public GxEPD2_GFX_BASE_CLASS
           if (dest_ye > dest_ys)
           {
             fillScreen(GxEPD_WHITE);
-            drawCallback(pv);
+            _drawPage(drawCallback, pv);
             epd2.writeImage(_black_buffer, _color_buffer, _pw_x, dest_ys, _pw_w, dest_ye - dest_ys);
           }
         }
@@ -489,7 +603,7 @@ class GxEPD2_3C : public GxEPD2_GFX_BASE_CLASS
         {
           uint16_t page_ys = _current_page * _page_height;
           fillScreen(GxEPD_WHITE);
-          drawCallback(pv);
+          _drawPage(drawCallback, pv);
           epd2.writeImage(_black_buffer, _color_buffer, 0, page_ys, GxEPD2_Type::WIDTH, gx_uint16_min(_page_height, HEIGHT - page_ys));
         }
         if (epd2.panel == GxEPD2::GDEW0154Z04)
@@ -498,7 +612,7 @@ class GxEPD2_3C : public GxEPD2_GFX_BASE_CLASS
           {
             uint16_t page_ys = _current_page * _page_height;
             fillScreen(GxEPD_WHITE);
-            drawCallback(pv);
+            _drawPage(drawCallback, pv);
             epd2.writeImage(_black_buffer, _color_buffer, 0, page_ys, GxEPD2_Type::WIDTH, gx_uint16_min(_page_height, HEIGHT - page_ys));
           }
         }
@@ -506,10 +620,42 @@ class GxEPD2_3C : public GxEPD2_GFX_BASE_CLASS
         epd2.powerOff();
       }
       _current_page = 0;
+      _clearDirty();
+      if (_dl_replay)
+      {
+        _dl_replay = false;
+        _dlSetTextState(_dl_text_state);
+      }
+    }
+
+    // bitmaps are drawn in whole bytes of the buffer, see GxEPD2_Blit; per pixel while recording a display list
+    void drawBitmap(int16_t x, int16_t y, const uint8_t bitmap[], int16_t w, int16_t h, uint16_t color)
+    {
+      if (_dl_recording) return GxEPD2_GFX_BASE_CLASS::drawBitmap(x, y, bitmap, w, h, color);
+      _blit(x, y, bitmap, w, h, true, true, color, false, color);
+    }
+
+    void drawBitmap(int16_t x, int16_t y, const uint8_t bitmap[], int16_t w, int16_t h, uint16_t color, uint16_t bg)
+    {
+      if (_dl_recording) return GxEPD2_GFX_BASE_CLASS::drawBitmap(x, y, bitmap, w, h, color, bg);
+      _blit(x, y, bitmap, w, h, true, true, color, true, bg);
+    }
+
+    void drawBitmap(int16_t x, int16_t y, uint8_t* bitmap, int16_t w, int16_t h, uint16_t color)
+    {
+      if (_dl_recording) return GxEPD2_GFX_BASE_CLASS::drawBitmap(x, y, bitmap, w, h, color);
+      _blit(x, y, bitmap, w, h, false, true, color, false, color);
+    }
+
+    void drawBitmap(int16_t x, int16_t y, uint8_t* bitmap, int16_t w, int16_t h, uint16_t color, uint16_t bg)
+    {
+      if (_dl_recording) return GxEPD2_GFX_BASE_CLASS::drawBitmap(x, y, bitmap, w, h, color, bg);
+      _blit(x, y, bitmap, w, h, false, true, color, true, bg);
     }
 
     void drawInvertedBitmap(int16_t x, int16_t y, const uint8_t bitmap[], int16_t w, int16_t h, uint16_t color)
     {
+      if (!_dl_recording) return _blit(x, y, bitmap, w, h, true, false, color, true, color);
       // taken from Adafruit_GFX.cpp, modified
       int16_t byteWidth = (w + 7) / 8; // Bitmap scanline pad = whole byte
       uint8_t byte = 0;
@@ -537,10 +683,12 @@ class GxEPD2_3C : public GxEPD2_GFX_BASE_CLASS
     //  Support for Bitmaps (Sprites) to Controller Buffer and to Screen
     void clearScreen(uint8_t value = 0xFF) // init controller memory and screen (default white)
     {
+      awaitRefresh();
       epd2.clearScreen(value);
     }
     void writeScreenBuffer(uint8_t value = 0xFF) // init controller memory (default white)
     {
+      awaitRefresh();
       epd2.writeScreenBuffer(value);
     }
     // write to controller memory, without screen refresh; x and w should be multiple of 8
@@ -611,24 +759,191 @@ class GxEPD2_3C : public GxEPD2_GFX_BASE_CLASS
     }
     void refresh(bool partial_update_mode = false) // screen refresh from controller memory to full screen
     {
-      epd2.refresh(partial_update_mode);
-      if (!partial_update_mode) epd2.powerOff();
+      awaitRefresh();
+      _refresh(partial_update_mode);
+      if (!partial_update_mode) _powerOff();
     }
     void refresh(int16_t x, int16_t y, int16_t w, int16_t h) // screen refresh from controller memory, partial screen
     {
-      epd2.refresh(x, y, w, h);
+      awaitRefresh();
+      _refresh(x, y, w, h);
+    }
+    // non-blocking refresh, see displayAsync()
+    void refreshAsync(bool partial_update_mode = false)
+    {
+      _async_refresh = true;
+      refresh(partial_update_mode);
+      _async_refresh = false;
+    }
+    void refreshAsync(int16_t x, int16_t y, int16_t w, int16_t h)
+    {
+      _async_refresh = true;
+      refresh(x, y, w, h);
+      _async_refresh = false;
     }
     // turns off generation of panel driving voltages, avoids screen fading over time
     void powerOff()
     {
+      awaitRefresh();
       epd2.powerOff();
     }
     // turns powerOff() and sets controller to deep sleep for minimum power use, ONLY if wakeable by RST (rst >= 0)
     void hibernate()
     {
+      awaitRefresh();
       epd2.hibernate();
     }
   private:
+    // paged drawing steps after drawing of a page
+    bool _nextPage()
+    {
+      uint16_t page_ys = _current_page * _page_height;
+      if (_using_partial_mode)
+      {
+        //Serial.print("  nextPage("); Serial.print(_pw_x); Serial.print(", "); Serial.print(_pw_y); Serial.print(", ");
+        //Serial.print(_pw_w); Serial.print(", "); Serial.print(_pw_h); Serial.print(") P"); Serial.println(_current_page);
+        uint16_t page_ye = _current_page < int16_t(_pages - 1) ? page_ys + _page_height : HEIGHT;
+        uint16_t dest_ys = _pw_y + page_ys; // transposed
+        uint16_t dest_ye = gx_uint16_min(_pw_y + _pw_h, _pw_y + page_ye);
+        if (dest_ye > dest_ys)
+        {
+          //Serial.print("writeImage("); Serial.print(_pw_x); Serial.print(", "); Serial.print(dest_ys); Serial.print(", ");
+          //Serial.print(_pw_w); Serial.print(", "); Serial.print(dest_ye - dest_ys); Serial.println(")");
+          epd2.writeImage(_black_buffer, _color_buffer, _pw_x, dest_ys, _pw_w, dest_ye - dest_ys);
+        }
+        else
+        {
+          //Serial.print("writeImage("); Serial.print(_pw_x); Serial.print(", "); Serial.print(dest_ys); Serial.print(", ");
+          //Serial.print(_pw_w); Serial.print(", "); Serial.print(dest_ye - dest_ys); Serial.print(") skipped ");
+          //Serial.print(dest_ys); Serial.print(".."); Serial.println(dest_ye);
+        }
+        _current_page++;
+        if (_current_page == int16_t(_pages))
+        {
+          _current_page = 0;
+          if (!_second_phase)
+          {
+            _refresh(_pw_x, _pw_y, _pw_w, _pw_h);
+            if (epd2.hasFastPartialUpdate)
+            {
+              _second_phase = true;
+              return true;
+            }
+          }
+          _clearDirty();
+          return false;
+        }
+        fillScreen(GxEPD_WHITE);
+        return true;
+      }
+      else // full update
+      {
+        epd2.writeImage(_black_buffer, _color_buffer, 0, page_ys, GxEPD2_Type::WIDTH, gx_uint16_min(_page_height, HEIGHT - page_ys));
+        _current_page++;
+        if (_current_page == int16_t(_pages))
+        {
+          _current_page = 0;
+          if ((epd2.panel == GxEPD2::GDEW0154Z04) && (_pages > 1))
+          {
+            if (!_second_phase)
+            {
+              _refresh(false); // full update after first phase
+              _second_phase = true;
+              fillScreen(GxEPD_WHITE);
+              return true;
+            }
+            else _refresh(true); // partial update after second phase
+          } else _refresh(false); // full update after only phase
+          _powerOff();
+          _clearDirty();
+          return false;
+        }
+        fillScreen(GxEPD_WHITE);
+        return true;
+      }
+    }
+    // paged drawing steps after drawing of a page, nextPageBW()
+    bool _nextPageBW()
+    {
+      if (1 == _pages)
+      {
+        if (_using_partial_mode)
+        {
+          epd2.writeImageNew(_black_buffer, _pw_x, _pw_y, _pw_w, _pw_h);
+          epd2.refresh_bw(_pw_x, _pw_y, _pw_w, _pw_h);
+          epd2.writeImagePrevious(_black_buffer, _pw_x, _pw_y, _pw_w, _pw_h);
+        }
+        else // full update
+        {
+          epd2.writeImage(_black_buffer, 0, 0, GxEPD2_Type::WIDTH, HEIGHT);
+          epd2.refresh(false);
+          epd2.writeImagePrevious(_black_buffer, 0, 0, GxEPD2_Type::WIDTH, HEIGHT);
+          epd2.powerOff();
+        }
+        _clearDirty();
+        return false;
+      }
+      uint16_t page_ys = _current_page * _page_height;
+      if (_using_partial_mode)
+      {
+        //Serial.print("  nextPage("); Serial.print(_pw_x); Serial.print(", "); Serial.print(_pw_y); Serial.print(", ");
+        //Serial.print(_pw_w); Serial.print(", "); Serial.print(_pw_h); Serial.print(") P"); Serial.println(_current_page);
+        uint16_t page_ye = _current_page < (_pages - 1) ? page_ys + _page_height : HEIGHT;
+        uint16_t dest_ys = _pw_y + page_ys; // transposed
+        uint16_t dest_ye = gx_uint16_min(_pw_y + _pw_h, _pw_y + page_ye);
+        if (dest_ye > dest_ys)
+        {
+          //Serial.print("writeImage("); Serial.print(_pw_x); Serial.print(", "); Serial.print(dest_ys); Serial.print(", ");
+          //Serial.print(_pw_w); Serial.print(", "); Serial.print(dest_ye - dest_ys); Serial.println(")");
+          if (!_second_phase) epd2.writeImageNew(_black_buffer, _pw_x, dest_ys, _pw_w, dest_ye - dest_ys);
+          else epd2.writeImagePrevious(_black_buffer, _pw_x, dest_ys, _pw_w, dest_ye - dest_ys);
+        }
+        else
+        {
+          //Serial.print("writeImage("); Serial.print(_pw_x); Serial.print(", "); Serial.print(dest_ys); Serial.print(", ");
+          //Serial.print(_pw_w); Serial.print(", "); Serial.print(dest_ye - dest_ys); Serial.print(") skipped ");
+          //Serial.print(dest_ys); Serial.print(".."); Serial.println(dest_ye);
+        }
+        _current_page++;
+        if (_current_page == _pages)
+        {
+          _current_page = 0;
+          if (!_second_phase)
+          {
+            epd2.refresh_bw(_pw_x, _pw_y, _pw_w, _pw_h);
+            _second_phase = true;
+            fillScreen(GxEPD_WHITE);
+            return true;
+          }
+          _clearDirty();
+          return false;
+        }
+        fillScreen(GxEPD_WHITE);
+        return true;
+      }
+      else // full update
+      {
+        if (!_second_phase) epd2.writeImage(_black_buffer, 0, page_ys, GxEPD2_Type::WIDTH, gx_uint16_min(_page_height, HEIGHT - page_ys));
+        else epd2.writeImagePrevious(_black_buffer, 0, page_ys, GxEPD2_Type::WIDTH, gx_uint16_min(_page_height, HEIGHT - page_ys));
+        _current_page++;
+        if (_current_page == _pages)
+        {
+          _current_page = 0;
+          if (!_second_phase)
+          {
+            epd2.refresh(false); // full update after first phase
+            _second_phase = true;
+            fillScreen(GxEPD_WHITE);
+            return true;
+          }
+          epd2.powerOff();
+          _clearDirty();
+          return false;
+        }
+        fillScreen(GxEPD_WHITE);
+        return true;
+      }
+    }
     template <typename T> static inline void
     _swap_(T & a, T & b)
     {
@@ -664,14 +979,387 @@ class GxEPD2_3C : public GxEPD2_GFX_BASE_CLASS
           break;
       }
     }
+    // rectangle in rotated coordinates: clipped once, then filled in whole bytes of the buffer
+    void _fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color)
+    {
+      if (x < 0)
+      {
+        w += x;
+        x = 0;
+      }
+      if (y < 0)
+      {
+        h += y;
+        y = 0;
+      }
+      if (w > width() - x) w = width() - x;
+      if (h > height() - y) h = height() - y;
+      if ((w <= 0) || (h <= 0)) return;
+      if (_mirror) x = width() - x - w;
+      uint16_t ux = x, uy = y, uw = w, uh = h;
+      _rotate(ux, uy, uw, uh);
+      // transpose partial window to 0,0
+      int16_t xs = int16_t(ux) - int16_t(_pw_x), xe = xs + int16_t(uw);
+      int16_t ys = int16_t(uy) - int16_t(_pw_y), ye = ys + int16_t(uh);
+      // clip to (partial) window
+      if (xs < 0) xs = 0;
+      if (ys < 0) ys = 0;
+      if (xe > int16_t(_pw_w)) xe = _pw_w;
+      if (ye > int16_t(_pw_h)) ye = _pw_h;
+      // adjust for current page, clip to it
+      int16_t page_ys = _current_page * _page_height;
+      ys = (ys > page_ys) ? ys - page_ys : 0;
+      ye = (ye - page_ys < int16_t(_page_height)) ? ye - page_ys : _page_height;
+      if ((xs >= xe) || (ys >= ye)) return;
+      _markDirty(xs, ys, xe, ye);
+      uint8_t black = (color == GxEPD_BLACK) ? 0x00 : 0xFF; // as drawPixel()
+      uint8_t red = ((color == GxEPD_RED) || (color == GxEPD_YELLOW)) ? 0x00 : 0xFF;
+      _fillBuffer(_black_buffer, black, xs, ys, xe, ye);
+      _fillBuffer(_color_buffer, red, xs, ys, xe, ye);
+    }
+    // pixels xs..xe-1 of rows ys..ye-1 set to data, masks for the partial bytes at the edges
+    void _fillBuffer(uint8_t* buffer, uint8_t data, int16_t xs, int16_t ys, int16_t xe, int16_t ye)
+    {
+      uint16_t row_bytes = _pw_w / 8;
+      uint16_t bs = xs / 8, be = (xe - 1) / 8;
+      uint8_t ms = 0xFF >> (xs % 8);
+      uint8_t me = 0xFF << (7 - (xe - 1) % 8);
+      if (bs == be) ms &= me;
+      for (int16_t y = ys; y < ye; y++)
+      {
+        uint8_t* p = buffer + uint32_t(y) * row_bytes + bs;
+        *p = (*p & ~ms) | (data & ms);
+        if (bs == be) continue;
+        if (be - bs > 1) memset(p + 1, data, be - bs - 1);
+        p[be - bs] = (p[be - bs] & ~me) | (data & me);
+      }
+    }
+    // buffer position of a pixel in rotated coordinates, as in drawPixel(), not clipped
+    void _bufferPosition(int16_t& x, int16_t& y)
+    {
+      if (_mirror) x = width() - x - 1;
+      switch (getRotation())
+      {
+        case 1:
+          _swap_(x, y);
+          x = WIDTH - x - 1;
+          break;
+        case 2:
+          x = WIDTH - x - 1;
+          y = HEIGHT - y - 1;
+          break;
+        case 3:
+          _swap_(x, y);
+          y = HEIGHT - y - 1;
+          break;
+      }
+      x -= _pw_x;
+      y -= _pw_y;
+      y -= _current_page * _page_height;
+    }
+    // 1bpp bitmap: bits set drawn in color1 if paint1, bits clear in color0 if paint0; clipped once, then in whole bytes
+    void _blit(int16_t x, int16_t y, const uint8_t* bitmap, int16_t w, int16_t h, bool pgm, bool paint1, uint16_t color1, bool paint0, uint16_t color0)
+    {
+      GxEPD2_Blit::Placement placement;
+      int16_t xs, ys, xe, ye;
+      if (!_blitPlacement(x, y, w, h, placement, xs, ys, xe, ye)) return;
+      _blitBox(placement, xs, ys, xe, ye, bitmap, w, h, pgm, paint1, color1, paint0, color0);
+    }
+    // placement of a w x h bitmap at x, y, and its part xs..xe-1 of rows ys..ye-1 of the current page; false if none
+    bool _blitPlacement(int16_t x, int16_t y, int16_t w, int16_t h, GxEPD2_Blit::Placement& placement, int16_t& xs, int16_t& ys, int16_t& xe, int16_t& ye)
+    {
+      // buffer positions of bitmap pixels (0, 0), (1, 0) and (0, 1) give the placement
+      int16_t x0 = x, y0 = y, xi = x + 1, yi = y, xj = x, yj = y + 1;
+      _bufferPosition(x0, y0);
+      _bufferPosition(xi, yi);
+      _bufferPosition(xj, yj);
+      placement.x0 = x0;
+      placement.y0 = y0;
+      placement.transposed = (xi == x0);
+      placement.dx = placement.transposed ? xj - x0 : xi - x0;
+      placement.dy = placement.transposed ? yi - y0 : yj - y0;
+      // clip to screen, (partial) window and current page
+      xs = 0;
+      ys = 0;
+      xe = gx_uint16_min(_pw_w, WIDTH - _pw_x);
+      ye = int16_t(_pw_h) - _current_page * _page_height;
+      if (ye > int16_t(_page_height)) ye = _page_height;
+      return GxEPD2_Blit::clip(xs, ys, xe, ye, placement, w, h);
+    }
+    void _blitBox(const GxEPD2_Blit::Placement& placement, int16_t xs, int16_t ys, int16_t xe, int16_t ye,
+                  const uint8_t* bitmap, int16_t w, int16_t h, bool pgm, bool paint1, uint16_t color1, bool paint0, uint16_t color0)
+    {
+      _markDirty(xs, ys, xe, ye);
+      // as drawPixel(): black in black buffer, red or yellow in color buffer, white else
+      uint8_t paint_1 = paint1 ? 0xFF : 0x00, paint_0 = paint0 ? 0xFF : 0x00;
+      GxEPD2_Blit::Mode black = {paint_1, uint8_t(color1 == GxEPD_BLACK ? 0x00 : 0xFF), paint_0, uint8_t(color0 == GxEPD_BLACK ? 0x00 : 0xFF)};
+      GxEPD2_Blit::Mode red = {paint_1, uint8_t((color1 == GxEPD_RED) || (color1 == GxEPD_YELLOW) ? 0x00 : 0xFF),
+                               paint_0, uint8_t((color0 == GxEPD_RED) || (color0 == GxEPD_YELLOW) ? 0x00 : 0xFF)
+                              };
+      GxEPD2_Blit::blit(_black_buffer, _pw_w / 8, xs, ys, xe, ye, placement, bitmap, w, h, pgm, black);
+      GxEPD2_Blit::blit(_color_buffer, _pw_w / 8, xs, ys, xe, ye, placement, bitmap, w, h, pgm, red);
+    }
+    // GFXfont text of text size 1 a glyph at a time with the blitter, other text through Adafruit_GFX
+    size_t _write(uint8_t c)
+    {
+      if (!gfxFont || (textsize_x != 1) || (textsize_y != 1)) return GxEPD2_GFX_BASE_CLASS::write(c);
+      // taken from Adafruit_GFX.cpp, modified
+      if (c == '\n')
+      {
+        cursor_x = 0;
+        cursor_y += _fontByte(&gfxFont->yAdvance);
+      }
+      else if (c != '\r')
+      {
+        uint16_t first = _fontWord(&gfxFont->first);
+        if ((c >= first) && (c <= _fontWord(&gfxFont->last)))
+        {
+          const GFXglyph* glyph = _fontGlyphs() + (c - first);
+          uint8_t w = _fontByte(&glyph->width), h = _fontByte(&glyph->height);
+          if ((w > 0) && (h > 0))
+          {
+            int16_t xo = int8_t(_fontByte(&glyph->xOffset)), yo = int8_t(_fontByte(&glyph->yOffset));
+            if (wrap && ((cursor_x + xo + w) > _width))
+            {
+              cursor_x = 0;
+              cursor_y += _fontByte(&gfxFont->yAdvance);
+            }
+            _drawGlyph(cursor_x + xo, cursor_y + yo, c, glyph, w, h);
+          }
+          cursor_x += _fontByte(&glyph->xAdvance);
+        }
+      }
+      return 1;
+    }
+    // glyph w x h at x, y in textcolor, background not drawn; nothing is expanded for glyphs outside the current page
+    void _drawGlyph(int16_t x, int16_t y, uint8_t c, const GFXglyph* glyph, uint8_t w, uint8_t h)
+    {
+      GxEPD2_Blit::Placement placement;
+      int16_t xs, ys, xe, ye;
+      if (!_blitPlacement(x, y, w, h, placement, xs, ys, xe, ye)) return;
+      const uint8_t* bits = _fontBitmap() + _fontWord(&glyph->bitmapOffset);
+      const uint8_t* bitmap = _glyph_cache.find(gfxFont, c);
+      if (!bitmap) bitmap = _glyph_cache.add(gfxFont, c, bits, w, h);
+      if (bitmap) return _blitBox(placement, xs, ys, xe, ye, bitmap, w, h, false, true, textcolor, false, textcolor);
+      // no cache, or glyph too big for it: bands of rows that intersect the current page
+      uint8_t band[64];
+      uint8_t rows = sizeof(band) / ((w + 7) / 8);
+      for (uint16_t r = 0; r < h; r += rows)
+      {
+        uint8_t n = (h - r < rows) ? h - r : rows;
+        if (!_blitPlacement(x, y + r, w, n, placement, xs, ys, xe, ye)) continue;
+        GxEPD2_GlyphCache::expand(bits, uint32_t(r) * w, w, n, band);
+        _blitBox(placement, xs, ys, xe, ye, band, w, n, false, true, textcolor, false, textcolor);
+      }
+    }
+    // GFXfont data, in program memory on AVR, ESP8266 and ESP32
+    static uint8_t _fontByte(const void* p)
+    {
+#if defined(__AVR) || defined(ESP8266) || defined(ESP32)
+      return pgm_read_byte(p);
+#else
+      return *(const uint8_t*)p;
+#endif
+    }
+    static uint16_t _fontWord(const void* p)
+    {
+#if defined(__AVR) || defined(ESP8266) || defined(ESP32)
+      return pgm_read_word(p);
+#else
+      return *(const uint16_t*)p;
+#endif
+    }
+    const GFXglyph* _fontGlyphs()
+    {
+#if defined(__AVR)
+      return (const GFXglyph*)pgm_read_word(&gfxFont->glyph);
+#else
+      return gfxFont->glyph;
+#endif
+    }
+    const uint8_t* _fontBitmap()
+    {
+#if defined(__AVR)
+      return (const uint8_t*)pgm_read_word(&gfxFont->bitmap);
+#else
+      return gfxFont->bitmap;
+#endif
+    }
+    // refresh steps, deferred to poll() in asynchronous mode
+    void _refresh(bool partial_update_mode)
+    {
+      if (_async_refresh) epd2.refreshAsync(partial_update_mode);
+      else epd2.refresh(partial_update_mode);
+    }
+    void _refresh(int16_t x, int16_t y, int16_t w, int16_t h)
+    {
+      if (_async_refresh) epd2.refreshAsync(x, y, w, h);
+      else epd2.refresh(x, y, w, h);
+    }
+    void _powerOff()
+    {
+      if (_async_refresh) _deferred_power_off = true;
+      else epd2.powerOff();
+    }
+    // bounding box of changes in buffer coordinates, for displayChanged()
+    void _markDirty(int16_t xs, int16_t ys, int16_t xe, int16_t ye)
+    {
+      if (xs < _dirty_xs) _dirty_xs = xs;
+      if (ys < _dirty_ys) _dirty_ys = ys;
+      if (xe > _dirty_xe) _dirty_xe = xe;
+      if (ye > _dirty_ye) _dirty_ye = ye;
+      if (ys < _drawn_ys) _drawn_ys = ys;
+      if (ye > _drawn_ye) _drawn_ye = ye;
+    }
+    void _clearDirty()
+    {
+      _dirty_xs = _dirty_ys = INT16_MAX;
+      _dirty_xe = _dirty_ye = 0;
+    }
+    // display list: records a command with the pages it intersects; while writing a character, collects its pages
+    void _dlRecord(uint8_t command, int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color)
+    {
+      uint16_t first, last;
+      if (!_dlPageRange(x, y, w, h, first, last)) return;
+      if (_dl_nested)
+      {
+        _dl_first_page = gx_uint16_min(_dl_first_page, first);
+        _dl_last_page = gx_uint16_max(_dl_last_page, last);
+        return;
+      }
+      GxEPD2_DisplayList::Shape shape = {color, x, y, (command == GxEPD2_DisplayList::VLine) ? h : w, h};
+      _display_list.add(command, first, last, &shape, sizeof(shape));
+    }
+    // pages of a rectangle in rotated coordinates, as in drawPixel(); false if outside of (partial) window
+    bool _dlPageRange(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t& first, uint16_t& last)
+    {
+      int16_t x1 = x + w - 1, y1 = y + h - 1;
+      if (_mirror)
+      {
+        x = width() - x - 1;
+        x1 = width() - x1 - 1;
+      }
+      int16_t ys = y, ye = y1;
+      switch (getRotation())
+      {
+        case 1:
+          ys = x;
+          ye = x1;
+          break;
+        case 2:
+          ys = HEIGHT - y - 1;
+          ye = HEIGHT - y1 - 1;
+          break;
+        case 3:
+          ys = HEIGHT - x - 1;
+          ye = HEIGHT - x1 - 1;
+          break;
+      }
+      ys -= _pw_y;
+      ye -= _pw_y;
+      if (ys > ye) _swap_(ys, ye);
+      if ((ye < 0) || (ys >= int16_t(_pw_h))) return false;
+      first = (ys < 0) ? 0 : ys / _page_height;
+      last = ((ye < int16_t(_pw_h)) ? ye : _pw_h - 1) / _page_height;
+      return true;
+    }
+    // end of recording: all pages from the display list, or loop body for each page if it didn't fit
+    bool _dlReplayPages()
+    {
+      _dl_recording = false;
+      if (_display_list.overflow()) return true;
+      _dlGetTextState(_dl_text_state);
+      do
+      {
+        _dlReplay();
+      }
+      while (_nextPage());
+      _dlSetTextState(_dl_text_state);
+      return false;
+    }
+    // draws the commands of the display list that intersect the current page
+    void _dlReplay()
+    {
+      union
+      {
+        GxEPD2_DisplayList::Shape shape;
+        GxEPD2_DisplayList::Character character;
+      } data;
+      for (uint32_t i = _display_list.first(_current_page); i < _display_list.end(_current_page); i = _display_list.next(i))
+      {
+        switch (_display_list.get(i, _current_page, &data, sizeof(data)))
+        {
+          case GxEPD2_DisplayList::Pixel:
+            drawPixel(data.shape.x, data.shape.y, data.shape.color);
+            break;
+          case GxEPD2_DisplayList::HLine:
+            drawFastHLine(data.shape.x, data.shape.y, data.shape.w, data.shape.color);
+            break;
+          case GxEPD2_DisplayList::VLine:
+            drawFastVLine(data.shape.x, data.shape.y, data.shape.w, data.shape.color);
+            break;
+          case GxEPD2_DisplayList::Rect:
+            fillRect(data.shape.x, data.shape.y, data.shape.w, data.shape.h, data.shape.color);
+            break;
+          case GxEPD2_DisplayList::Fill:
+            fillScreen(data.shape.color);
+            break;
+          case GxEPD2_DisplayList::Char:
+            _dlSetTextState(data.character);
+            _write(data.character.c);
+            break;
+        }
+      }
+    }
+    void _drawPage(void (*drawCallback)(const void*), const void* pv)
+    {
+      if (_dl_replay) _dlReplay();
+      else drawCallback(pv);
+    }
+    void _dlGetTextState(GxEPD2_DisplayList::Character& state)
+    {
+      state.font = gfxFont;
+      state.cursor_x = cursor_x;
+      state.cursor_y = cursor_y;
+      state.textcolor = textcolor;
+      state.textbgcolor = textbgcolor;
+      state.c = 0;
+      state.textsize_x = textsize_x;
+      state.textsize_y = textsize_y;
+      state.wrap = wrap;
+    }
+    void _dlSetTextState(const GxEPD2_DisplayList::Character& state)
+    {
+      gfxFont = (GFXfont*)state.font;
+      cursor_x = state.cursor_x;
+      cursor_y = state.cursor_y;
+      textcolor = state.textcolor;
+      textbgcolor = state.textbgcolor;
+      textsize_x = state.textsize_x;
+      textsize_y = state.textsize_y;
+      wrap = state.wrap;
+    }
   private:
-    uint8_t _black_buffer[(GxEPD2_Type::WIDTH / 8) * page_height];
-    uint8_t _color_buffer[(GxEPD2_Type::WIDTH / 8) * page_height];
+    GxEPD2_BufferStorage<GxEPD2_Buffer::external, buffer_size> _buffer_storage;
+    GxEPD2_BufferPool* _pool;
+    uint8_t* _black_buffer;
+    uint8_t* _color_buffer;
     bool _using_partial_mode, _second_phase, _mirror;
     uint16_t _width_bytes, _pixel_bytes;
     int16_t _current_page;
     uint16_t _pages, _page_height;
     uint16_t _pw_x, _pw_y, _pw_w, _pw_h;
+    bool _async_refresh, _deferred_power_off;
+    int16_t _dirty_xs, _dirty_ys, _dirty_xe, _dirty_ye;
+    bool _filled; // since fillScreen() with _fill_black and _fill_red, only rows _drawn_ys.._drawn_ye-1 were drawn
+    uint8_t _fill_black, _fill_red;
+    int16_t _drawn_ys, _drawn_ye;
+    GxEPD2_DisplayList _display_list;
+    GxEPD2_GlyphCache _glyph_cache;
+    bool _dl_recording, _dl_replay;
+    uint8_t _dl_nested;
+    uint16_t _dl_first_page, _dl_last_page;
+    GxEPD2_DisplayList::Character _dl_text_state;
 };
 
 #endif
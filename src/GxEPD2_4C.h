@@ -30,6 +30,9 @@
 #endif
 
 #include "GxEPD2_EPD.h"
+#include "GxEPD2_DisplayList.h"
+#include "GxEPD2_Buffer.h"
+#include "GxEPD2_BufferPool.h"
 
 // for __has_include see https://en.cppreference.com/w/cpp/preprocessor/include
 // see also https://gcc.gnu.org/onlinedocs/cpp/_005f_005fhas_005finclude.html
@@ -73,25 +76,69 @@
 #include "epd4c/GxEPD2_1160c_GDEY116F51.h"
 #endif
 
-template<typename GxEPD2_Type, const uint16_t page_height>
+template<typename GxEPD2_Type, const uint16_t page_height, typename GxEPD2_Buffer = GxEPD2_InternalBuffer>
 class GxEPD2_4C : public GxEPD2_GFX_BASE_CLASS
 {
   public:
     GxEPD2_Type epd2;
+    // bytes of the display buffer, see GxEPD2_Buffer.h
+    static const uint32_t buffer_size = (GxEPD2_Type::WIDTH / 4) * uint32_t(page_height);
+    // buffer: buffer_size bytes with GxEPD2_ExternalBuffer, unused else
 #if ENABLE_GxEPD2_GFX
-    GxEPD2_4C(GxEPD2_Type epd2_instance) : GxEPD2_GFX_BASE_CLASS(epd2, GxEPD2_Type::WIDTH_VISIBLE, GxEPD2_Type::HEIGHT), epd2(epd2_instance)
+    GxEPD2_4C(GxEPD2_Type epd2_instance, uint8_t* buffer = 0) : GxEPD2_GFX_BASE_CLASS(epd2, GxEPD2_Type::WIDTH_VISIBLE, GxEPD2_Type::HEIGHT), epd2(epd2_instance)
 #else
-    GxEPD2_4C(GxEPD2_Type epd2_instance) : GxEPD2_GFX_BASE_CLASS(GxEPD2_Type::WIDTH_VISIBLE, GxEPD2_Type::HEIGHT), epd2(epd2_instance)
+    GxEPD2_4C(GxEPD2_Type epd2_instance, uint8_t* buffer = 0) : GxEPD2_GFX_BASE_CLASS(GxEPD2_Type::WIDTH_VISIBLE, GxEPD2_Type::HEIGHT), epd2(epd2_instance)
 #endif
     {
+      _pixel_buffer = GxEPD2_Buffer::external ? buffer : _buffer_storage.data();
+      _pool = 0;
       _page_height = page_height;
       _pages = (HEIGHT / _page_height) + ((HEIGHT % _page_height) > 0);
       _mirror = false;
       _using_partial_mode = false;
       _current_page = 0;
+      _async_refresh = false;
+      _deferred_power_off = false;
+      _dl_recording = false;
+      _dl_replay = false;
+      _dl_nested = 0;
+      _filled = false;
+      _drawn_ys = INT16_MAX;
+      _drawn_ye = 0;
+      _clearDirty();
       setFullWindow();
     }
 
+    // with GxEPD2_ExternalBuffer: the buffer is borrowed from pool, see GxEPD2_BufferPool.h;
+    // a pool smaller than buffer_size gives a smaller page height, as with the buffer size below
+    GxEPD2_4C(GxEPD2_Type epd2_instance, GxEPD2_BufferPool& pool) : GxEPD2_4C(epd2_instance, pool.buffer(), pool.size())
+    {
+      static_assert(GxEPD2_Buffer::external, "GxEPD2_BufferPool needs GxEPD2_ExternalBuffer");
+      _pool = &pool;
+    }
+
+    // a static pool must hold buffer_size, see GxEPD2_BufferPoolSize
+    template<const uint32_t pool_size>
+    GxEPD2_4C(GxEPD2_Type epd2_instance, GxEPD2_StaticBufferPool<pool_size>& pool) : GxEPD2_4C(epd2_instance, static_cast<GxEPD2_BufferPool&>(pool))
+    {
+      static_assert(pool_size >= buffer_size, "GxEPD2_StaticBufferPool smaller than buffer_size of this display class");
+    }
+
+    // with GxEPD2_ExternalBuffer: buffer of size bytes, e.g. allocated at init, of at least one line: buffer_size / page_height;
+    // the page height is the largest that fits, at most page_height, see GxEPD2_pageHeight() in GxEPD2_Buffer.h;
+    // pages() is 0 if not even one line fits, e.g. size 0 after a failed malloc(), then nothing is displayed
+    GxEPD2_4C(GxEPD2_Type epd2_instance, uint8_t* buffer, uint32_t size) : GxEPD2_4C(epd2_instance, buffer)
+    {
+      static_assert(GxEPD2_Buffer::external, "a buffer size needs GxEPD2_ExternalBuffer");
+      _page_height = GxEPD2_pageHeight(GxEPD2_Type::HEIGHT, buffer_size / page_height, (size < buffer_size) ? size : buffer_size);
+      _pages = _page_height ? (HEIGHT / _page_height) + ((HEIGHT % _page_height) > 0) : 0;
+    }
+
+    ~GxEPD2_4C()
+    {
+      if (_pool) _pool->release(this);
+    }
+
     uint16_t pages()
     {
       return _pages;
@@ -108,8 +155,19 @@ class GxEPD2_4C : public GxEPD2_GFX_BASE_CLASS
       return m;
     }
 
+    // optional display list for paged drawing (pages() > 1), buffer of size bytes, nullptr disables it:
+    // the drawing is recorded once and replayed for each page, instead of executing the drawing code for each page.
+    // firstPage()/nextPage(): the loop body is executed once, nextPage() does all pages; drawPaged(): drawCallback is called once.
+    // needs 8 bytes per page, and 11 bytes per pixel, 13 per line, 15 per rectangle, 21 per character (32 bit);
+    // if the buffer is too small, the drawing code is executed for each page, as without display list
+    void setDisplayList(uint8_t* buffer, uint32_t size)
+    {
+      _display_list.setBuffer(buffer, size);
+    }
+
     void drawPixel(int16_t x, int16_t y, uint16_t color)
     {
+      if (_dl_recording) return _dlRecord(GxEPD2_DisplayList::Pixel, x, y, 1, 1, color);
       if ((x < 0) || (x >= width()) || (y < 0) || (y >= height())) return;
       if (_mirror) x = width() - x - 1;
       // check rotation, move pixel around if necessary
@@ -138,6 +196,7 @@ class GxEPD2_4C : public GxEPD2_GFX_BASE_CLASS
       // check if in current page
       if ((y < 0) || (y >= int16_t(_page_height))) return;
       uint32_t i = x / 4 + uint32_t(y) * (_pw_w / 4);
+      _markDirty(x, y, x + 1, y + 1);
       uint8_t pv = color4(color);
       switch(x % 4)
       {
@@ -148,6 +207,51 @@ class GxEPD2_4C : public GxEPD2_GFX_BASE_CLASS
       }
     }
 
+    void drawFastHLine(int16_t x, int16_t y, int16_t w, uint16_t color)
+    {
+      if (_dl_recording) return _dlRecord(GxEPD2_DisplayList::HLine, x, y, w, 1, color);
+      if (w < 0) // as GFXcanvas1
+      {
+        w = -w;
+        x -= w - 1;
+      }
+      _fillRect(x, y, w, 1, color);
+    }
+
+    void drawFastVLine(int16_t x, int16_t y, int16_t h, uint16_t color)
+    {
+      if (_dl_recording) return _dlRecord(GxEPD2_DisplayList::VLine, x, y, 1, h, color);
+      if (h < 0) // as GFXcanvas1
+      {
+        h = -h;
+        y -= h - 1;
+      }
+      _fillRect(x, y, 1, h, color);
+    }
+
+    void fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color)
+    {
+      if (_dl_recording) return _dlRecord(GxEPD2_DisplayList::Rect, x, y, w, h, color);
+      _fillRect(x, y, w, h, color);
+    }
+
+    using GxEPD2_GFX_BASE_CLASS::write;
+    size_t write(uint8_t c)
+    {
+      if (!_dl_recording || _dl_nested) return GxEPD2_GFX_BASE_CLASS::write(c);
+      // record the character with the text state, write it for cursor advance and pages
+      GxEPD2_DisplayList::Character character;
+      _dlGetTextState(character);
+      character.c = c;
+      _dl_first_page = _pages;
+      _dl_last_page = 0;
+      _dl_nested++;
+      size_t rv = GxEPD2_GFX_BASE_CLASS::write(c);
+      _dl_nested--;
+      if (_dl_first_page <= _dl_last_page) _display_list.add(GxEPD2_DisplayList::Char, _dl_first_page, _dl_last_page, &character, sizeof(character));
+      return rv;
+    }
+
     void init(uint32_t serial_diag_bitrate = 0) // = 0 : disabled
     {
       epd2.init(serial_diag_bitrate);
@@ -184,24 +288,44 @@ class GxEPD2_4C : public GxEPD2_GFX_BASE_CLASS
     // release SPI and control pins
     void end() 
     {
+      awaitRefresh();
       epd2.end();
     }
 
     void fillScreen(uint16_t color)
     {
+      if (_dl_recording) return _dlRecord(GxEPD2_DisplayList::Fill, 0, 0, width(), height(), color);
+      if (_pool && !_pool->acquire(this)) _filled = false; // drawn by other display objects since
       uint8_t pv = color4(color) * 0x55; // 0b01010101
-      for (uint32_t x = 0; x < sizeof(_pixel_buffer); x++)
+      // the part of the buffer used by the window; only the rows drawn since, if filled with the same before
+      // and not drawn by other display objects, as an external buffer may be, unless from a pool
+      uint16_t row_bytes = _pw_w / 4;
+      int16_t ys = _drawn_ys, ye = _drawn_ye;
+      if (!_filled || (pv != _fill_data) || (GxEPD2_Buffer::external && !_pool))
+      {
+        ys = 0;
+        ye = _page_height;
+      }
+      if (ys < ye)
       {
-        _pixel_buffer[x] = pv;
+        memset(_pixel_buffer + uint32_t(ys) * row_bytes, pv, uint32_t(ye - ys) * row_bytes);
+        _markDirty(0, ys, _pw_w, ye); // the rows not drawn since are unchanged, for displayChanged()
       }
+      _filled = true;
+      _fill_data = pv;
+      _drawn_ys = INT16_MAX;
+      _drawn_ye = 0;
     }
 
     // display buffer content to screen, useful for full screen buffer
     void display(bool partial_update_mode = false)
     {
+      if (0 == _pages) return; // no buffer, see constructor with buffer size
+      awaitRefresh();
       epd2.writeNative(_pixel_buffer, 0, 0, 0, GxEPD2_Type::WIDTH, _page_height);
-      epd2.refresh(partial_update_mode);
-      if (!partial_update_mode) epd2.powerOff();
+      _refresh(partial_update_mode);
+      if (!partial_update_mode) _powerOff();
+      _clearDirty();
     }
 
     // display part of buffer content to screen, useful for full screen buffer
@@ -212,13 +336,90 @@ class GxEPD2_4C : public GxEPD2_GFX_BASE_CLASS
     // this is an addressing limitation of the e-paper controllers
     void displayWindow(uint16_t x, uint16_t y, uint16_t w, uint16_t h)
     {
+      if (0 == _pages) return; // no buffer, see constructor with buffer size
+      awaitRefresh();
       x = gx_uint16_min(x, width());
       y = gx_uint16_min(y, height());
       w = gx_uint16_min(w, width() - x);
       h = gx_uint16_min(h, height() - y);
       _rotate(x, y, w, h);
       epd2.writeNativePart(_pixel_buffer, 0, x, y, GxEPD2_Type::WIDTH, _page_height, x, y, w, h);
-      epd2.refresh(x, y, w, h);
+      _refresh(x, y, w, h);
+    }
+
+    // display the changed part of buffer content to screen, with partial refresh, useful for full screen buffer
+    // changes by drawing since the last display() or displayChanged() are tracked as a bounding box,
+    // increased to multiple of 8 in x direction of the controller; does nothing if unchanged;
+    // for full window and one page only, else does display(true)
+    void displayChanged()
+    {
+      if (0 == _pages) return; // no buffer, see constructor with buffer size
+      awaitRefresh();
+      if ((_dirty_xe <= _dirty_xs) || (_dirty_ye <= _dirty_ys)) return;
+      if (_using_partial_mode || (_pages > 1)) return display(true); // the bounding box is relative to window and page
+      uint16_t x = _dirty_xs - _dirty_xs % 8;
+      uint16_t y = _dirty_ys;
+      uint16_t w = gx_uint16_min(_dirty_xe + (8 - _dirty_xe % 8) % 8, GxEPD2_Type::WIDTH) - x;
+      uint16_t h = _dirty_ye - _dirty_ys;
+      _clearDirty();
+      epd2.writeNativePart(_pixel_buffer, 0, x, y, GxEPD2_Type::WIDTH, _page_height, x, y, w, h);
+      _refresh(x, y, w, h);
+    }
+
+    // non-blocking variants of display(), displayWindow(), nextPage() and refresh():
+    // these return as soon as the refresh is started; the powerOff after the refresh
+    // is deferred and done by poll() or awaitRefresh().
+    void displayAsync(bool partial_update_mode = false)
+    {
+      _async_refresh = true;
+      display(partial_update_mode);
+      _async_refresh = false;
+    }
+
+    void displayWindowAsync(uint16_t x, uint16_t y, uint16_t w, uint16_t h)
+    {
+      _async_refresh = true;
+      displayWindow(x, y, w, h);
+      _async_refresh = false;
+    }
+
+    void displayChangedAsync()
+    {
+      _async_refresh = true;
+      displayChanged();
+      _async_refresh = false;
+    }
+
+    bool nextPageAsync()
+    {
+      _async_refresh = true;
+      bool rv = nextPage();
+      _async_refresh = false;
+      return rv;
+    }
+
+    // true while an asynchronous refresh or its deferred powerOff is not completed
+    bool isBusy()
+    {
+      return epd2.isBusy() || _deferred_power_off;
+    }
+
+    // does the deferred powerOff as soon as the panel is ready; returns true while busy, call from loop()
+    bool poll()
+    {
+      if (epd2.poll()) return true;
+      if (_deferred_power_off)
+      {
+        _deferred_power_off = false;
+        epd2.powerOffAsync();
+      }
+      return epd2.poll();
+    }
+
+    // waits for completion of an asynchronous refresh and its deferred powerOff
+    void awaitRefresh()
+    {
+      while (poll()) epd2.awaitRefresh();
     }
 
     void setFullWindow()
@@ -228,6 +429,7 @@ class GxEPD2_4C : public GxEPD2_GFX_BASE_CLASS
       _pw_y = 0;
       _pw_w = GxEPD2_Type::WIDTH;
       _pw_h = HEIGHT;
+      _filled = false; // row length changed
     }
 
     // setPartialWindow, use parameters according to actual rotation.
@@ -244,6 +446,7 @@ class GxEPD2_4C : public GxEPD2_GFX_BASE_CLASS
       _pw_h = gx_uint16_min(h, height() - _pw_y);
       _rotate(_pw_x, _pw_y, _pw_w, _pw_h);
       _using_partial_mode = true;
+      _filled = false; // row length changed
       // make _pw_x, _pw_w multiple of 4
       _pw_w += _pw_x % 4;
       if (_pw_w % 4 > 0) _pw_w += 4 - _pw_w % 4;
@@ -252,81 +455,38 @@ class GxEPD2_4C : public GxEPD2_GFX_BASE_CLASS
 
     void firstPage()
     {
+      if (0 == _pages) return; // no buffer, see constructor with buffer size
+      awaitRefresh();
       fillScreen(GxEPD_WHITE);
       _current_page = 0;
       _second_phase = false;
       epd2.setPaged(); // for GxEPD2_565c paged workaround
+      _dl_recording = _display_list.isEnabled() && (_pages > 1);
+      if (_dl_recording) _display_list.begin(_pages);
     }
 
     bool nextPage()
     {
-      uint16_t page_ys = _current_page * _page_height;
-      if (_using_partial_mode)
-      {
-        //Serial.print("  nextPage("); Serial.print(_pw_x); Serial.print(", "); Serial.print(_pw_y); Serial.print(", ");
-        //Serial.print(_pw_w); Serial.print(", "); Serial.print(_pw_h); Serial.print(") P"); Serial.println(_current_page);
-        uint16_t page_ye = _current_page < int16_t(_pages - 1) ? page_ys + _page_height : HEIGHT;
-        uint16_t dest_ys = _pw_y + page_ys; // transposed
-        uint16_t dest_ye = gx_uint16_min(_pw_y + _pw_h, _pw_y + page_ye);
-        if (dest_ye > dest_ys)
-        {
-          //Serial.print("writeImage("); Serial.print(_pw_x); Serial.print(", "); Serial.print(dest_ys); Serial.print(", ");
-          //Serial.print(_pw_w); Serial.print(", "); Serial.print(dest_ye - dest_ys); Serial.println(")");
-          epd2.writeNative(_pixel_buffer, 0, _pw_x, dest_ys, _pw_w, dest_ye - dest_ys);
-        }
-        else
-        {
-          //Serial.print("writeImage("); Serial.print(_pw_x); Serial.print(", "); Serial.print(dest_ys); Serial.print(", ");
-          //Serial.print(_pw_w); Serial.print(", "); Serial.print(dest_ye - dest_ys); Serial.print(") skipped ");
-          //Serial.print(dest_ys); Serial.print(".."); Serial.println(dest_ye);
-        }
-        _current_page++;
-        if (_current_page == int16_t(_pages))
-        {
-          _current_page = 0;
-          if (!_second_phase)
-          {
-            epd2.refresh(_pw_x, _pw_y, _pw_w, _pw_h);
-            if (epd2.hasFastPartialUpdate)
-            {
-              _second_phase = true;
-              return true;
-            }
-          }
-          return false;
-        }
-        fillScreen(GxEPD_WHITE);
-        return true;
-      }
-      else // full update
-      {
-        epd2.writeNative(_pixel_buffer, 0, 0, page_ys, GxEPD2_Type::WIDTH, gx_uint16_min(_page_height, HEIGHT - page_ys));
-        _current_page++;
-        if (_current_page == int16_t(_pages))
-        {
-          _current_page = 0;
-          if ((epd2.panel == GxEPD2::GDEW0154Z04) && (_pages > 1))
-          {
-            if (!_second_phase)
-            {
-              epd2.refresh(false); // full update after first phase
-              _second_phase = true;
-              fillScreen(GxEPD_WHITE);
-              return true;
-            }
-            else epd2.refresh(true); // partial update after second phase
-          } else epd2.refresh(false); // full update after only phase
-          epd2.powerOff();
-          return false;
-        }
-        fillScreen(GxEPD_WHITE);
-        return true;
-      }
+      if (0 == _pages) return false; // no buffer, see constructor with buffer size
+      if (!_dl_recording) return _nextPage();
+      return _dlReplayPages();
     }
 
     // GxEPD style paged drawing; drawCallback() is called as many times as needed
     void drawPaged(void (*drawCallback)(const void*), const void* pv)
     {
+      if (0 == _pages) return; // no buffer, see constructor with buffer size
+      awaitRefresh();
+      if (_display_list.isEnabled() && (_pages > 1))
+      {
+        // record once, replay for each page, if it fits
+        _display_list.begin(_pages);
+        _dl_recording = true;
+        drawCallback(pv);
+        _dl_recording = false;
+        _dl_replay = !_display_list.overflow();
+        _dlGetTextState(_dl_text_state);
+      }
       if (_using_partial_mode)
       {
         for (_current_page = 0; _current_page < _pages; _current_page++)
@@ -338,7 +498,7 @@ class GxEPD2_4C : public GxEPD2_GFX_BASE_CLASS
           if (dest_ye > dest_ys)
           {
             fillScreen(GxEPD_WHITE);
-            drawCallback(pv);
+            _drawPage(drawCallback, pv);
             epd2.writeNative(_pixel_buffer, 0, _pw_x, dest_ys, _pw_w, dest_ye - dest_ys);
           }
         }
@@ -351,13 +511,19 @@ class GxEPD2_4C : public GxEPD2_GFX_BASE_CLASS
         {
           uint16_t page_ys = _current_page * _page_height;
           fillScreen(GxEPD_WHITE);
-          drawCallback(pv);
+          _drawPage(drawCallback, pv);
           epd2.writeNative(_pixel_buffer, 0, 0, page_ys, GxEPD2_Type::WIDTH, gx_uint16_min(_page_height, HEIGHT - page_ys));
         }
         epd2.refresh(false); // full update
         epd2.powerOff();
       }
       _current_page = 0;
+      _clearDirty();
+      if (_dl_replay)
+      {
+        _dl_replay = false;
+        _dlSetTextState(_dl_text_state);
+      }
     }
 
     void drawInvertedBitmap(int16_t x, int16_t y, const uint8_t bitmap[], int16_t w, int16_t h, uint16_t color)
@@ -389,10 +555,12 @@ class GxEPD2_4C : public GxEPD2_GFX_BASE_CLASS
     //  Support for Bitmaps (Sprites) to Controller Buffer and to Screen
     void clearScreen(uint8_t value = 0xFF) // init controller memory and screen (default white)
     {
+      awaitRefresh();
       epd2.clearScreen(value);
     }
     void writeScreenBuffer(uint8_t value = 0xFF) // init controller memory (default white)
     {
+      awaitRefresh();
       epd2.writeScreenBuffer(value);
     }
     // write to controller memory, without screen refresh; x and w should be multiple of 8
@@ -463,24 +631,109 @@ class GxEPD2_4C : public GxEPD2_GFX_BASE_CLASS
     }
     void refresh(bool partial_update_mode = false) // screen refresh from controller memory to full screen
     {
-      epd2.refresh(partial_update_mode);
-      if (!partial_update_mode) epd2.powerOff();
+      awaitRefresh();
+      _refresh(partial_update_mode);
+      if (!partial_update_mode) _powerOff();
     }
     void refresh(int16_t x, int16_t y, int16_t w, int16_t h) // screen refresh from controller memory, partial screen
     {
-      epd2.refresh(x, y, w, h);
+      awaitRefresh();
+      _refresh(x, y, w, h);
+    }
+    // non-blocking refresh, see displayAsync()
+    void refreshAsync(bool partial_update_mode = false)
+    {
+      _async_refresh = true;
+      refresh(partial_update_mode);
+      _async_refresh = false;
+    }
+    void refreshAsync(int16_t x, int16_t y, int16_t w, int16_t h)
+    {
+      _async_refresh = true;
+      refresh(x, y, w, h);
+      _async_refresh = false;
     }
     // turns off generation of panel driving voltages, avoids screen fading over time
     void powerOff()
     {
+      awaitRefresh();
       epd2.powerOff();
     }
     // turns powerOff() and sets controller to deep sleep for minimum power use, ONLY if wakeable by RST (rst >= 0)
     void hibernate()
     {
+      awaitRefresh();
       epd2.hibernate();
     }
   private:
+    // paged drawing steps after drawing of a page
+    bool _nextPage()
+    {
+      uint16_t page_ys = _current_page * _page_height;
+      if (_using_partial_mode)
+      {
+        //Serial.print("  nextPage("); Serial.print(_pw_x); Serial.print(", "); Serial.print(_pw_y); Serial.print(", ");
+        //Serial.print(_pw_w); Serial.print(", "); Serial.print(_pw_h); Serial.print(") P"); Serial.println(_current_page);
+        uint16_t page_ye = _current_page < int16_t(_pages - 1) ? page_ys + _page_height : HEIGHT;
+        uint16_t dest_ys = _pw_y + page_ys; // transposed
+        uint16_t dest_ye = gx_uint16_min(_pw_y + _pw_h, _pw_y + page_ye);
+        if (dest_ye > dest_ys)
+        {
+          //Serial.print("writeImage("); Serial.print(_pw_x); Serial.print(", "); Serial.print(dest_ys); Serial.print(", ");
+          //Serial.print(_pw_w); Serial.print(", "); Serial.print(dest_ye - dest_ys); Serial.println(")");
+          epd2.writeNative(_pixel_buffer, 0, _pw_x, dest_ys, _pw_w, dest_ye - dest_ys);
+        }
+        else
+        {
+          //Serial.print("writeImage("); Serial.print(_pw_x); Serial.print(", "); Serial.print(dest_ys); Serial.print(", ");
+          //Serial.print(_pw_w); Serial.print(", "); Serial.print(dest_ye - dest_ys); Serial.print(") skipped ");
+          //Serial.print(dest_ys); Serial.print(".."); Serial.println(dest_ye);
+        }
+        _current_page++;
+        if (_current_page == int16_t(_pages))
+        {
+          _current_page = 0;
+          if (!_second_phase)
+          {
+            _refresh(_pw_x, _pw_y, _pw_w, _pw_h);
+            if (epd2.hasFastPartialUpdate)
+            {
+              _second_phase = true;
+              return true;
+            }
+          }
+          _clearDirty();
+          return false;
+        }
+        fillScreen(GxEPD_WHITE);
+        return true;
+      }
+      else // full update
+      {
+        epd2.writeNative(_pixel_buffer, 0, 0, page_ys, GxEPD2_Type::WIDTH, gx_uint16_min(_page_height, HEIGHT - page_ys));
+        _current_page++;
+        if (_current_page == int16_t(_pages))
+        {
+          _current_page = 0;
+          if ((epd2.panel == GxEPD2::GDEW0154Z04) && (_pages > 1))
+          {
+            if (!_second_phase)
+            {
+              _refresh(false); // full update after first phase
+              _second_phase = true;
+              fillScreen(GxEPD_WHITE);
+              return true;
+            }
+            else _refresh(true); // partial update after second phase
+          } else _refresh(false); // full update after only phase
+          _powerOff();
+          _clearDirty();
+          return false;
+        }
+        fillScreen(GxEPD_WHITE);
+        return true;
+      }
+    }
     template <typename T> static inline void
     _swap_(T & a, T & b)
     {
@@ -516,6 +769,90 @@ class GxEPD2_4C : public GxEPD2_GFX_BASE_CLASS
           break;
       }
     }
+    // rectangle in rotated coordinates: clipped once, then filled in whole bytes of the buffer
+    void _fillRect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color)
+    {
+      if (x < 0)
+      {
+        w += x;
+        x = 0;
+      }
+      if (y < 0)
+      {
+        h += y;
+        y = 0;
+      }
+      if (w > width() - x) w = width() - x;
+      if (h > height() - y) h = height() - y;
+      if ((w <= 0) || (h <= 0)) return;
+      if (_mirror) x = width() - x - w;
+      uint16_t ux = x, uy = y, uw = w, uh = h;
+      _rotate(ux, uy, uw, uh);
+      // transpose partial window to 0,0
+      int16_t xs = int16_t(ux) - int16_t(_pw_x), xe = xs + int16_t(uw);
+      int16_t ys = int16_t(uy) - int16_t(_pw_y), ye = ys + int16_t(uh);
+      // clip to (partial) window
+      if (xs < 0) xs = 0;
+      if (ys < 0) ys = 0;
+      if (xe > int16_t(_pw_w)) xe = _pw_w;
+      if (ye > int16_t(_pw_h)) ye = _pw_h;
+      // adjust for current page, clip to it
+      int16_t page_ys = _current_page * _page_height;
+      ys = (ys > page_ys) ? ys - page_ys : 0;
+      ye = (ye - page_ys < int16_t(_page_height)) ? ye - page_ys : _page_height;
+      if ((xs >= xe) || (ys >= ye)) return;
+      _markDirty(xs, ys, xe, ye);
+      uint8_t data = color4(color) * 0x55; // 0b01010101
+      _fillBuffer(_pixel_buffer, data, xs, ys, xe, ye);
+    }
+    // pixels xs..xe-1 of rows ys..ye-1 set to data, masks for the partial bytes at the edges
+    void _fillBuffer(uint8_t* buffer, uint8_t data, int16_t xs, int16_t ys, int16_t xe, int16_t ye)
+    {
+      uint16_t row_bytes = _pw_w / 4;
+      uint16_t bs = xs / 4, be = (xe - 1) / 4;
+      uint8_t ms = 0xFF >> (2 * (xs % 4));
+      uint8_t me = 0xFF << (2 * (3 - (xe - 1) % 4));
+      if (bs == be) ms &= me;
+      for (int16_t y = ys; y < ye; y++)
+      {
+        uint8_t* p = buffer + uint32_t(y) * row_bytes + bs;
+        *p = (*p & ~ms) | (data & ms);
+        if (bs == be) continue;
+        if (be - bs > 1) memset(p + 1, data, be - bs - 1);
+        p[be - bs] = (p[be - bs] & ~me) | (data & me);
+      }
+    }
+    // refresh steps, deferred to poll() in asynchronous mode
+    void _refresh(bool partial_update_mode)
+    {
+      if (_async_refresh) epd2.refreshAsync(partial_update_mode);
+      else epd2.refresh(partial_update_mode);
+    }
+    void _refresh(int16_t x, int16_t y, int16_t w, int16_t h)
+    {
+      if (_async_refresh) epd2.refreshAsync(x, y, w, h);
+      else epd2.refresh(x, y, w, h);
+    }
+    void _powerOff()
+    {
+      if (_async_refresh) _deferred_power_off = true;
+      else epd2.powerOff();
+    }
+    // bounding box of changes in buffer coordinates, for displayChanged()
+    void _markDirty(int16_t xs, int16_t ys, int16_t xe, int16_t ye)
+    {
+      if (xs < _dirty_xs) _dirty_xs = xs;
+      if (ys < _dirty_ys) _dirty_ys = ys;
+      if (xe > _dirty_xe) _dirty_xe = xe;
+      if (ye > _dirty_ye) _dirty_ye = ye;
+      if (ys < _drawn_ys) _drawn_ys = ys;
+      if (ye > _drawn_ye) _drawn_ye = ye;
+    }
+    void _clearDirty()
+    {
+      _dirty_xs = _dirty_ys = INT16_MAX;
+      _dirty_xe = _dirty_ye = 0;
+    }
     uint8_t color4(uint16_t color)
     {
       static uint16_t _prev_color = GxEPD_BLACK;
@@ -551,13 +888,148 @@ class GxEPD2_4C : public GxEPD2_GFX_BASE_CLASS
       _prev_color4 = cv4;
       return cv4;
     }
+    // display list: records a command with the pages it intersects; while writing a character, collects its pages
+    void _dlRecord(uint8_t command, int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color)
+    {
+      uint16_t first, last;
+      if (!_dlPageRange(x, y, w, h, first, last)) return;
+      if (_dl_nested)
+      {
+        _dl_first_page = gx_uint16_min(_dl_first_page, first);
+        _dl_last_page = gx_uint16_max(_dl_last_page, last);
+        return;
+      }
+      GxEPD2_DisplayList::Shape shape = {color, x, y, (command == GxEPD2_DisplayList::VLine) ? h : w, h};
+      _display_list.add(command, first, last, &shape, sizeof(shape));
+    }
+    // pages of a rectangle in rotated coordinates, as in drawPixel(); false if outside of (partial) window
+    bool _dlPageRange(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t& first, uint16_t& last)
+    {
+      int16_t x1 = x + w - 1, y1 = y + h - 1;
+      if (_mirror)
+      {
+        x = width() - x - 1;
+        x1 = width() - x1 - 1;
+      }
+      int16_t ys = y, ye = y1;
+      switch (getRotation())
+      {
+        case 1:
+          ys = x;
+          ye = x1;
+          break;
+        case 2:
+          ys = HEIGHT - y - 1;
+          ye = HEIGHT - y1 - 1;
+          break;
+        case 3:
+          ys = HEIGHT - x - 1;
+          ye = HEIGHT - x1 - 1;
+          break;
+      }
+      ys -= _pw_y;
+      ye -= _pw_y;
+      if (ys > ye) _swap_(ys, ye);
+      if ((ye < 0) || (ys >= int16_t(_pw_h))) return false;
+      first = (ys < 0) ? 0 : ys / _page_height;
+      last = ((ye < int16_t(_pw_h)) ? ye : _pw_h - 1) / _page_height;
+      return true;
+    }
+    // end of recording: all pages from the display list, or loop body for each page if it didn't fit
+    bool _dlReplayPages()
+    {
+      _dl_recording = false;
+      if (_display_list.overflow()) return true;
+      _dlGetTextState(_dl_text_state);
+      do
+      {
+        _dlReplay();
+      }
+      while (_nextPage());
+      _dlSetTextState(_dl_text_state);
+      return false;
+    }
+    // draws the commands of the display list that intersect the current page
+    void _dlReplay()
+    {
+      union
+      {
+        GxEPD2_DisplayList::Shape shape;
+        GxEPD2_DisplayList::Character character;
+      } data;
+      for (uint32_t i = _display_list.first(_current_page); i < _display_list.end(_current_page); i = _display_list.next(i))
+      {
+        switch (_display_list.get(i, _current_page, &data, sizeof(data)))
+        {
+          case GxEPD2_DisplayList::Pixel:
+            drawPixel(data.shape.x, data.shape.y, data.shape.color);
+            break;
+          case GxEPD2_DisplayList::HLine:
+            drawFastHLine(data.shape.x, data.shape.y, data.shape.w, data.shape.color);
+            break;
+          case GxEPD2_DisplayList::VLine:
+            drawFastVLine(data.shape.x, data.shape.y, data.shape.w, data.shape.color);
+            break;
+          case GxEPD2_DisplayList::Rect:
+            fillRect(data.shape.x, data.shape.y, data.shape.w, data.shape.h, data.shape.color);
+            break;
+          case GxEPD2_DisplayList::Fill:
+            fillScreen(data.shape.color);
+            break;
+          case GxEPD2_DisplayList::Char:
+            _dlSetTextState(data.character);
+            GxEPD2_GFX_BASE_CLASS::write(data.character.c);
+            break;
+        }
+      }
+    }
+    void _drawPage(void (*drawCallback)(const void*), const void* pv)
+    {
+      if (_dl_replay) _dlReplay();
+      else drawCallback(pv);
+    }
+    void _dlGetTextState(GxEPD2_DisplayList::Character& state)
+    {
+      state.font = gfxFont;
+      state.cursor_x = cursor_x;
+      state.cursor_y = cursor_y;
+      state.textcolor = textcolor;
+      state.textbgcolor = textbgcolor;
+      state.c = 0;
+      state.textsize_x = textsize_x;
+      state.textsize_y = textsize_y;
+      state.wrap = wrap;
+    }
+    void _dlSetTextState(const GxEPD2_DisplayList::Character& state)
+    {
+      gfxFont = (GFXfont*)state.font;
+      cursor_x = state.cursor_x;
+      cursor_y = state.cursor_y;
+      textcolor = state.textcolor;
+      textbgcolor = state.textbgcolor;
+      textsize_x = state.textsize_x;
+      textsize_y = state.textsize_y;
+      wrap = state.wrap;
+    }
   private:
-    uint8_t _pixel_buffer[(GxEPD2_Type::WIDTH / 4) * page_height];
+    GxEPD2_BufferStorage<GxEPD2_Buffer::external, buffer_size> _buffer_storage;
+    GxEPD2_BufferPool* _pool;
+    uint8_t* _pixel_buffer;
     bool _using_partial_mode, _second_phase, _mirror;
     uint16_t _width_bytes, _pixel_bytes;
     int16_t _current_page;
     uint16_t _pages, _page_height;
     uint16_t _pw_x, _pw_y, _pw_w, _pw_h;
+    bool _async_refresh, _deferred_power_off;
+    int16_t _dirty_xs, _dirty_ys, _dirty_xe, _dirty_ye;
+    bool _filled; // since fillScreen() with _fill_data, only rows _drawn_ys.._drawn_ye-1 were drawn
+    uint8_t _fill_data;
+    int16_t _drawn_ys, _drawn_ye;
+    GxEPD2_DisplayList _display_list;
+    bool _dl_recording, _dl_replay;
+    uint8_t _dl_nested;
+    uint16_t _dl_first_page, _dl_last_page;
+    GxEPD2_DisplayList::Character _dl_text_state;
 };
 
 #endif
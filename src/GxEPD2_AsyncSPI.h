@@ -0,0 +1,35 @@
+// Display Library for SPI e-paper panels from Dalian Good Display and boards from Waveshare.
+// Requires HW SPI and Adafruit_GFX. Caution: the e-paper panels require 3.3V supply AND data lines!
+//
+// Display Library based on Demo Example from Good Display: https://www.good-display.com/companyfile/32/
+//
+// Author: Jean-Marc Zingg
+//
+// Version: see library.properties
+//
+// Library: https://github.com/ZinggJM/GxEPD2
+//
+// GxEPD2_AsyncSPI: interface for a queued (e.g. DMA) SPI backend, for asynchronous image upload by GxEPD2_EPD.
+// the backend sends queued blocks on the SPI bus selected for GxEPD2_EPD, in queue order.
+// GxEPD2_EPD controls CS, DC and the SPI transaction, the backend only moves data.
+// the transaction is held from the first queued block until GxEPD2_EPD::awaitTransfer(), so the backend needs no bus lock;
+// other devices on the same bus must not be accessed meanwhile.
+// see GxEPD2_EPD::selectAsyncTransfer()
+
+#ifndef _GxEPD2_AsyncSPI_H_
+#define _GxEPD2_AsyncSPI_H_
+
+#include <stdint.h>
+
+class GxEPD2_AsyncSPI
+{
+  public:
+    virtual ~GxEPD2_AsyncSPI() {};
+    // queue n bytes from data for transfer; data is not modified and stays valid until the transfer is completed.
+    // must accept at least 2 queued blocks; returns false if the queue is full (the block is not queued).
+    virtual bool queue(const uint8_t* data, uint16_t n) = 0;
+    // number of queued blocks not yet completed; called repeatedly while waiting for completion.
+    virtual uint8_t pending() = 0;
+};
+
+#endif
@@ -0,0 +1,152 @@
+// Display Library for SPI e-paper panels from Dalian Good Display and boards from Waveshare.
+// Requires HW SPI and Adafruit_GFX. Caution: the e-paper panels require 3.3V supply AND data lines!
+//
+// Display Library based on Demo Example from Good Display: https://www.good-display.com/companyfile/32/
+//
+// Author: Jean-Marc Zingg
+//
+// Version: see library.properties
+//
+// Library: https://github.com/ZinggJM/GxEPD2
+
+#include <Arduino.h>
+#include "GxEPD2_Blit.h"
+
+#if defined(__AVR)
+#include <avr/pgmspace.h>
+#endif
+
+static inline uint8_t _read(const uint8_t* p, bool pgm)
+{
+#if defined(__AVR) || defined(ESP8266) || defined(ESP32)
+  if (pgm) return pgm_read_byte(p);
+#endif
+  return *p;
+}
+
+// 8 bits of a bitmap row from bit k on, MSB first; bits outside of the row are 0
+static inline uint8_t _bits(const uint8_t* row, int16_t bytes, int16_t k, bool pgm)
+{
+  int16_t q = (k + 8) / 8 - 1; // k >= -8
+  uint8_t s = k & 7;
+  uint16_t hi = ((q >= 0) && (q < bytes)) ? _read(row + q, pgm) : 0;
+  uint16_t lo = ((q + 1 >= 0) && (q + 1 < bytes)) ? _read(row + q + 1, pgm) : 0;
+  return uint16_t(((hi << 8) | lo) << s) >> 8;
+}
+
+static inline void _put(uint8_t* p, uint8_t bits, uint8_t range, const GxEPD2_Blit::Mode& mode)
+{
+  uint8_t paint = ((bits & mode.paint1) | (~bits & mode.paint0)) & range;
+  uint8_t value = (bits & mode.value1) | (~bits & mode.value0);
+  *p = (*p & ~paint) | (value & paint);
+}
+
+// buffer pixels of byte b within xs..xe-1
+static inline uint8_t _range(int16_t b, int16_t xs, int16_t xe)
+{
+  int16_t bxs = 8 * b;
+  return (0xFF >> ((xs > bxs) ? xs - bxs : 0)) & (0xFF << ((xe < bxs + 8) ? bxs + 8 - xe : 0));
+}
+
+void GxEPD2_Blit::blit(uint8_t* buffer, uint16_t row_bytes, int16_t xs, int16_t ys, int16_t xe, int16_t ye,
+                       const Placement& placement, const uint8_t* bitmap, int16_t w, int16_t h, bool pgm, const Mode& mode)
+{
+  int16_t bytes = (w + 7) / 8; // bitmap scanline pad = whole byte
+  int16_t bs = xs / 8, be = (xe - 1) / 8;
+  if (!placement.transposed)
+  {
+    // bitmap rows along buffer rows
+    for (int16_t y = ys; y < ye; y++)
+    {
+      const uint8_t* row = bitmap + int32_t((y - placement.y0) * placement.dy) * bytes;
+      uint8_t* p = buffer + uint32_t(y) * row_bytes;
+      for (int16_t b = bs; b <= be; b++)
+      {
+        uint8_t bits;
+        if (placement.dx > 0) bits = _bits(row, bytes, 8 * b - placement.x0, pgm);
+        else bits = reverse(_bits(row, bytes, placement.x0 - 8 * b - 7, pgm));
+        _put(p + b, bits, _range(b, xs, xe), mode);
+      }
+    }
+    return;
+  }
+  // bitmap columns along buffer rows: the 8 bitmap rows of a buffer byte, transposed a bitmap byte at a time
+  int16_t i0 = (ys - placement.y0) * placement.dy, i1 = (ye - 1 - placement.y0) * placement.dy;
+  if (i0 > i1)
+  {
+    int16_t t = i0;
+    i0 = i1;
+    i1 = t;
+  }
+  for (int16_t b = bs; b <= be; b++)
+  {
+    uint8_t range = _range(b, xs, xe);
+    const uint8_t* rows[8];
+    for (int16_t k = 0; k < 8; k++)
+    {
+      rows[k] = (range & (0x80 >> k)) ? bitmap + int32_t((8 * b + k - placement.x0) * placement.dx) * bytes : 0;
+    }
+    for (int16_t q = i0 / 8; q <= i1 / 8; q++)
+    {
+      uint8_t a[8];
+      for (int16_t k = 0; k < 8; k++) a[k] = rows[k] ? _read(rows[k] + q, pgm) : 0;
+      transpose(a);
+      for (int16_t n = 0; n < 8; n++)
+      {
+        int16_t i = 8 * q + n;
+        if ((i < i0) || (i > i1)) continue;
+        int16_t y = placement.y0 + placement.dy * i;
+        _put(buffer + uint32_t(y) * row_bytes + b, a[n], range, mode);
+      }
+    }
+  }
+}
+
+bool GxEPD2_Blit::clip(int16_t& xs, int16_t& ys, int16_t& xe, int16_t& ye, const Placement& placement, int16_t w, int16_t h)
+{
+  if ((w <= 0) || (h <= 0)) return false;
+  int16_t bw = placement.transposed ? h : w;
+  int16_t bh = placement.transposed ? w : h;
+  int16_t bxs = (placement.dx > 0) ? placement.x0 : placement.x0 - bw + 1;
+  int16_t bys = (placement.dy > 0) ? placement.y0 : placement.y0 - bh + 1;
+  if (xs < bxs) xs = bxs;
+  if (ys < bys) ys = bys;
+  if (xe > bxs + bw) xe = bxs + bw;
+  if (ye > bys + bh) ye = bys + bh;
+  return (xs < xe) && (ys < ye);
+}
+
+void GxEPD2_Blit::transpose(uint8_t a[8])
+{
+  // Hacker's Delight, transpose8rS32
+  uint32_t x = (uint32_t(a[0]) << 24) | (uint32_t(a[1]) << 16) | (uint32_t(a[2]) << 8) | a[3];
+  uint32_t y = (uint32_t(a[4]) << 24) | (uint32_t(a[5]) << 16) | (uint32_t(a[6]) << 8) | a[7];
+  uint32_t t;
+  t = (x ^ (x >> 7)) & 0x00AA00AA;
+  x = x ^ t ^ (t << 7);
+  t = (y ^ (y >> 7)) & 0x00AA00AA;
+  y = y ^ t ^ (t << 7);
+  t = (x ^ (x >> 14)) & 0x0000CCCC;
+  x = x ^ t ^ (t << 14);
+  t = (y ^ (y >> 14)) & 0x0000CCCC;
+  y = y ^ t ^ (t << 14);
+  t = (x & 0xF0F0F0F0) | ((y >> 4) & 0x0F0F0F0F);
+  y = ((x << 4) & 0xF0F0F0F0) | (y & 0x0F0F0F0F);
+  x = t;
+  a[0] = x >> 24;
+  a[1] = x >> 16;
+  a[2] = x >> 8;
+  a[3] = x;
+  a[4] = y >> 24;
+  a[5] = y >> 16;
+  a[6] = y >> 8;
+  a[7] = y;
+}
+
+uint8_t GxEPD2_Blit::reverse(uint8_t b)
+{
+  b = (b & 0xF0) >> 4 | (b & 0x0F) << 4;
+  b = (b & 0xCC) >> 2 | (b & 0x33) << 2;
+  b = (b & 0xAA) >> 1 | (b & 0x55) << 1;
+  return b;
+}
@@ -0,0 +1,45 @@
+// Display Library for SPI e-paper panels from Dalian Good Display and boards from Waveshare.
+// Requires HW SPI and Adafruit_GFX. Caution: the e-paper panels require 3.3V supply AND data lines!
+//
+// Display Library based on Demo Example from Good Display: https://www.good-display.com/companyfile/32/
+//
+// Author: Jean-Marc Zingg
+//
+// Version: see library.properties
+//
+// Library: https://github.com/ZinggJM/GxEPD2
+//
+// GxEPD2_Blit: 1bpp bitmaps (MSB first, rows padded to whole bytes) into 1bpp display buffers, a byte at a time.
+// rows of the bitmap along buffer rows are shifted and merged, or bit reversed; along buffer columns they are
+// transposed in blocks of 8x8 pixels. used by the display templates for drawBitmap(), drawInvertedBitmap() and the like.
+
+#ifndef _GxEPD2_Blit_H_
+#define _GxEPD2_Blit_H_
+
+#include <stdint.h>
+
+class GxEPD2_Blit
+{
+  public:
+    // for bitmap bits set (1) and clear (0): paint 0xFF or leave 0x00, buffer value 0xFF or 0x00
+    struct Mode
+    {
+      uint8_t paint1, value1, paint0, value0;
+    };
+    // buffer pixel of bitmap pixel (i, j): (x0 + dx * i, y0 + dy * j), transposed (x0 + dx * j, y0 + dy * i); dx, dy 1 or -1
+    struct Placement
+    {
+      int16_t x0, y0;
+      int8_t dx, dy;
+      bool transposed;
+    };
+    // buffer pixels xs..xe-1 of rows ys..ye-1, must be covered by the bitmap; pgm: bitmap in program memory
+    static void blit(uint8_t* buffer, uint16_t row_bytes, int16_t xs, int16_t ys, int16_t xe, int16_t ye,
+                     const Placement& placement, const uint8_t* bitmap, int16_t w, int16_t h, bool pgm, const Mode& mode);
+    // clips the bitmap to buffer pixels xs..xe-1 of rows ys..ye-1, false if nothing remains
+    static bool clip(int16_t& xs, int16_t& ys, int16_t& xe, int16_t& ye, const Placement& placement, int16_t w, int16_t h);
+    static void transpose(uint8_t a[8]); // 8x8 bits, a[n] gets column n, MSB first
+    static uint8_t reverse(uint8_t b); // bit order
+};
+
+#endif
@@ -0,0 +1,83 @@
+// Display Library for SPI e-paper panels from Dalian Good Display and boards from Waveshare.
+// Requires HW SPI and Adafruit_GFX. Caution: the e-paper panels require 3.3V supply AND data lines!
+//
+// Display Library based on Demo Example from Good Display: https://www.good-display.com/companyfile/32/
+//
+// Author: Jean-Marc Zingg
+//
+// Version: see library.properties
+//
+// Library: https://github.com/ZinggJM/GxEPD2
+//
+// buffer policy of the display templates: the buffer is a member of the display object, the default,
+// or supplied to its constructor, e.g. in PSRAM, or shared by display objects that are drawn and refreshed one after the other:
+//   uint8_t* buffer = (uint8_t*)ps_malloc(GxEPD2_BW<GxEPD2_it78_1872x1404, GxEPD2_it78_1872x1404::HEIGHT, GxEPD2_RuntimeOrientation, GxEPD2_ExternalBuffer>::buffer_size);
+//   GxEPD2_BW<GxEPD2_it78_1872x1404, GxEPD2_it78_1872x1404::HEIGHT, GxEPD2_RuntimeOrientation, GxEPD2_ExternalBuffer> display(GxEPD2_it78_1872x1404(...), buffer);
+// buffer_size of the display class is the size needed, for GxEPD2_3C both the black and the color buffer.
+// display objects that are drawn one at a time can borrow the buffer from a pool instead, see GxEPD2_BufferPool.h
+// the page height can be derived from a buffer budget, at compile time with GxEPD2_PageHeight, e.g. instead of MAX_HEIGHT(EPD):
+//   GxEPD2_BW<GxEPD2_750_T7, GxEPD2_PageHeight<GxEPD2_BW<GxEPD2_750_T7, 1>, 16000>::value> display(GxEPD2_750_T7(...));
+// or at init, with an external buffer of the size available, e.g. from the heap, and the template page height as upper limit:
+//   GxEPD2_BW<GxEPD2_750_T7, GxEPD2_750_T7::HEIGHT, GxEPD2_RuntimeOrientation, GxEPD2_ExternalBuffer> display(GxEPD2_750_T7(...), buffer, size);
+
+#ifndef _GxEPD2_Buffer_H_
+#define _GxEPD2_Buffer_H_
+
+#include <stdint.h>
+
+struct GxEPD2_InternalBuffer
+{
+  static const bool external = false;
+};
+
+struct GxEPD2_ExternalBuffer
+{
+  static const bool external = true;
+};
+
+// the buffer member of the display object, none if external
+template<const bool external, const uint32_t size>
+struct GxEPD2_BufferStorage
+{
+  uint8_t* data()
+  {
+    return _data;
+  };
+  uint8_t _data[size];
+};
+
+template<const uint32_t size>
+struct GxEPD2_BufferStorage<true, size>
+{
+  uint8_t* data()
+  {
+    return 0;
+  };
+};
+
+// page height for a buffer of at most budget bytes, line_bytes per line, for height lines:
+// the fewest pages, of equal height as far as possible, as the same number of pages needs no more commands with a smaller buffer;
+// a multiple of step, if that fits too, for controllers that address rows in groups; 0 if no line fits.
+constexpr uint16_t GxEPD2_pageHeightAligned(uint16_t even_height, uint16_t lines, uint16_t step)
+{
+  return ((even_height + step - 1) / step * step <= lines) ? (even_height + step - 1) / step * step : even_height;
+}
+
+constexpr uint16_t GxEPD2_pageHeightEven(uint16_t height, uint16_t lines, uint16_t step)
+{
+  return (0 == lines) ? 0 : GxEPD2_pageHeightAligned((height + (height + lines - 1) / lines - 1) / ((height + lines - 1) / lines), lines, step);
+}
+
+constexpr uint16_t GxEPD2_pageHeight(uint16_t height, uint32_t line_bytes, uint32_t budget, uint16_t step = 1)
+{
+  return GxEPD2_pageHeightEven(height, (budget / line_bytes < height) ? budget / line_bytes : height, step);
+}
+
+// page height of display class Display for a buffer of at most budget bytes, Display with page height 1, e.g. GxEPD2_3C<GxEPD2_290_C90c, 1>
+template<typename Display, const uint32_t budget, const uint16_t step = 1>
+struct GxEPD2_PageHeight
+{
+  static const uint16_t value = GxEPD2_pageHeight(decltype(Display::epd2)::HEIGHT, Display::buffer_size, budget, step);
+};
+
+#endif
@@ -0,0 +1,35 @@
+// Display Library for SPI e-paper panels from Dalian Good Display and boards from Waveshare.
+// Requires HW SPI and Adafruit_GFX. Caution: the e-paper panels require 3.3V supply AND data lines!
+//
+// Display Library based on Demo Example from Good Display: https://www.good-display.com/companyfile/32/
+//
+// Author: Jean-Marc Zingg
+//
+// Version: see library.properties
+//
+// Library: https://github.com/ZinggJM/GxEPD2
+
+#include "GxEPD2_BufferPool.h"
+
+GxEPD2_BufferPool::GxEPD2_BufferPool(uint8_t* buffer, uint32_t size) :
+  _buffer(buffer), _size(size), _user(0), _release(0)
+{
+}
+
+bool GxEPD2_BufferPool::acquire(void* user, void (*release)(void*))
+{
+  if (user == _user) return true;
+  void* previous = _user;
+  void (*previous_release)(void*) = _release;
+  _user = user;
+  _release = release;
+  if (previous && previous_release) previous_release(previous);
+  return false;
+}
+
+void GxEPD2_BufferPool::release(void* user)
+{
+  if (user != _user) return;
+  _user = 0;
+  _release = 0;
+}
@@ -0,0 +1,76 @@
+// Display Library for SPI e-paper panels from Dalian Good Display and boards from Waveshare.
+// Requires HW SPI and Adafruit_GFX. Caution: the e-paper panels require 3.3V supply AND data lines!
+//
+// Display Library based on Demo Example from Good Display: https://www.good-display.com/companyfile/32/
+//
+// Author: Jean-Marc Zingg
+//
+// Version: see library.properties
+//
+// Library: https://github.com/ZinggJM/GxEPD2
+//
+// GxEPD2_BufferPool: one buffer for display objects that are drawn one at a time, sized for the largest.
+// a display object borrows it with fillScreen(), also by firstPage() and drawPaged(), and keeps it until another one borrows it;
+// the previous user is released first, e.g. to do the deferred second write of its buffer, and fills all of it when it borrows again.
+//   typedef GxEPD2_BW<GxEPD2_154_D67, GxEPD2_154_D67::HEIGHT, GxEPD2_RuntimeOrientation, GxEPD2_ExternalBuffer> Display1;
+//   typedef GxEPD2_3C<GxEPD2_290_C90c, GxEPD2_290_C90c::HEIGHT, GxEPD2_ExternalBuffer> Display2;
+//   GxEPD2_StaticBufferPool<GxEPD2_BufferPoolSize<Display1, Display2>::value> buffer_pool;
+//   Display1 display1(GxEPD2_154_D67(...), buffer_pool);
+//   Display2 display2(GxEPD2_290_C90c(...), buffer_pool);
+// or GxEPD2_BufferPool buffer_pool(buffer, size) with a buffer of at least buffer_size of each display class, e.g. in PSRAM.
+
+#ifndef _GxEPD2_BufferPool_H_
+#define _GxEPD2_BufferPool_H_
+
+#include <stdint.h>
+
+class GxEPD2_BufferPool
+{
+  public:
+    GxEPD2_BufferPool(uint8_t* buffer, uint32_t size);
+    uint8_t* buffer()
+    {
+      return _buffer;
+    };
+    uint32_t size()
+    {
+      return _size;
+    };
+    // user borrows the buffer, release(previous user) is called before, if given;
+    // true if user had it already, i.e. the content is as user left it
+    bool acquire(void* user, void (*release)(void*) = 0);
+    // user no longer uses the buffer, e.g. when destroyed
+    void release(void* user);
+  private:
+    uint8_t* _buffer;
+    uint32_t _size;
+    void* _user;
+    void (*_release)(void*);
+};
+
+template<const uint32_t pool_size>
+class GxEPD2_StaticBufferPool : public GxEPD2_BufferPool
+{
+  public:
+    GxEPD2_StaticBufferPool() : GxEPD2_BufferPool(_data, pool_size) {};
+  private:
+    uint8_t _data[pool_size];
+};
+
+// the largest buffer_size of the display classes
+template<typename... Displays>
+struct GxEPD2_BufferPoolSize;
+
+template<typename Display>
+struct GxEPD2_BufferPoolSize<Display>
+{
+  static const uint32_t value = Display::buffer_size;
+};
+
+template<typename Display, typename... Displays>
+struct GxEPD2_BufferPoolSize<Display, Displays...>
+{
+  static const uint32_t value = (Display::buffer_size > GxEPD2_BufferPoolSize<Displays...>::value) ? Display::buffer_size : GxEPD2_BufferPoolSize<Displays...>::value;
+};
+
+#endif
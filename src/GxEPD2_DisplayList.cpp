@@ -0,0 +1,122 @@
+// Display Library for SPI e-paper panels from Dalian Good Display and boards from Waveshare.
+// Requires HW SPI and Adafruit_GFX. Caution: the e-paper panels require 3.3V supply AND data lines!
+//
+// Display Library based on Demo Example from Good Display: https://www.good-display.com/companyfile/32/
+//
+// Author: Jean-Marc Zingg
+//
+// Version: see library.properties
+//
+// Library: https://github.com/ZinggJM/GxEPD2
+
+#include "GxEPD2_DisplayList.h"
+#include <string.h>
+
+// command code, first page, last page
+#define GxEPD2_DL_HEADER_SIZE 5
+
+GxEPD2_DisplayList::GxEPD2_DisplayList() :
+  _buffer(0), _size(0), _used(0), _table(0), _pages(0), _overflow(false)
+{
+}
+
+void GxEPD2_DisplayList::setBuffer(uint8_t* buffer, uint32_t size)
+{
+  _buffer = 0;
+  _size = 0;
+  if (!buffer) return;
+  // page table of uint32_t at aligned start
+  uint8_t pad = (4 - (uintptr_t(buffer) & 3)) & 3;
+  if (size <= pad) return;
+  _buffer = buffer + pad;
+  _size = size - pad;
+  _table = (uint32_t*)_buffer;
+  _pages = 0;
+  _used = 0;
+}
+
+void GxEPD2_DisplayList::begin(uint16_t pages)
+{
+  _pages = pages;
+  _used = 8ul * pages;
+  _overflow = !_buffer || (_used > _size);
+  if (_overflow) return;
+  for (uint16_t p = 0; p < pages; p++)
+  {
+    _table[2 * p] = _used; // none yet: first == end
+    _table[2 * p + 1] = _used;
+  }
+}
+
+void GxEPD2_DisplayList::add(uint8_t command, uint16_t first_page, uint16_t last_page, const void* data, uint16_t size)
+{
+  if (_overflow) return;
+  uint16_t data_size = _dataSize(command);
+  if (size < data_size) data_size = size;
+  if (_used + GxEPD2_DL_HEADER_SIZE + data_size > _size)
+  {
+    _overflow = true;
+    return;
+  }
+  if (last_page >= _pages) last_page = _pages - 1;
+  uint8_t* p = _buffer + _used;
+  p[0] = command;
+  memcpy(p + 1, &first_page, 2);
+  memcpy(p + 3, &last_page, 2);
+  memcpy(p + GxEPD2_DL_HEADER_SIZE, data, data_size);
+  for (uint16_t page = first_page; page <= last_page; page++)
+  {
+    if (_table[2 * page] == _table[2 * page + 1]) _table[2 * page] = _used;
+    _table[2 * page + 1] = _used + GxEPD2_DL_HEADER_SIZE + data_size;
+  }
+  _used += GxEPD2_DL_HEADER_SIZE + data_size;
+}
+
+uint32_t GxEPD2_DisplayList::first(uint16_t page)
+{
+  return (_overflow || (page >= _pages)) ? 0 : _table[2 * page];
+}
+
+uint32_t GxEPD2_DisplayList::end(uint16_t page)
+{
+  return (_overflow || (page >= _pages)) ? 0 : _table[2 * page + 1];
+}
+
+uint32_t GxEPD2_DisplayList::next(uint32_t index)
+{
+  return index + GxEPD2_DL_HEADER_SIZE + _dataSize(_buffer[index]);
+}
+
+int16_t GxEPD2_DisplayList::get(uint32_t index, uint16_t page, void* data, uint16_t size)
+{
+  const uint8_t* p = _buffer + index;
+  uint16_t first_page, last_page;
+  memcpy(&first_page, p + 1, 2);
+  memcpy(&last_page, p + 3, 2);
+  if ((page < first_page) || (page > last_page)) return -1;
+  uint16_t data_size = _dataSize(p[0]);
+  if (size < data_size) data_size = size;
+  memset(data, 0, size);
+  memcpy(data, p + GxEPD2_DL_HEADER_SIZE, data_size);
+  return p[0];
+}
+
+uint16_t GxEPD2_DisplayList::_dataSize(uint8_t command)
+{
+  switch (command)
+  {
+    case Pixel:
+    case GreyPixel:
+      return 3 * sizeof(int16_t); // color, x, y
+    case HLine:
+    case VLine:
+      return 4 * sizeof(int16_t); // color, x, y, w
+    case Rect:
+      return sizeof(Shape);
+    case Fill:
+      return sizeof(uint16_t); // color
+    case Char:
+      return sizeof(Character);
+  }
+  return 0;
+}
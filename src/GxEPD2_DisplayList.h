@@ -0,0 +1,69 @@
+// Display Library for SPI e-paper panels from Dalian Good Display and boards from Waveshare.
+// Requires HW SPI and Adafruit_GFX. Caution: the e-paper panels require 3.3V supply AND data lines!
+//
+// Display Library based on Demo Example from Good Display: https://www.good-display.com/companyfile/32/
+//
+// Author: Jean-Marc Zingg
+//
+// Version: see library.properties
+//
+// Library: https://github.com/ZinggJM/GxEPD2
+//
+// GxEPD2_DisplayList: recorded drawing commands for paged drawing, in a buffer supplied by the user.
+// the display templates record the drawing once, and replay for each page the commands that intersect it.
+// buffer layout: for each page the offsets of its first and behind its last command, then the commands,
+// each with command code, first and last page, and the command data.
+
+#ifndef _GxEPD2_DisplayList_H_
+#define _GxEPD2_DisplayList_H_
+
+#include <stdint.h>
+
+class GxEPD2_DisplayList
+{
+  public:
+    enum Command {Pixel, HLine, VLine, Rect, GreyPixel, Fill, Char};
+    // data of Pixel, HLine, VLine, Rect, GreyPixel and Fill; only the needed leading part is stored
+    struct Shape
+    {
+      uint16_t color; // grey for GreyPixel
+      int16_t x, y;
+      int16_t w, h; // length for HLine and VLine in w
+    };
+    // data of Char: character written with the text state before
+    struct Character
+    {
+      const void* font;
+      int16_t cursor_x, cursor_y;
+      uint16_t textcolor, textbgcolor;
+      uint8_t c, textsize_x, textsize_y, wrap;
+    };
+    GxEPD2_DisplayList();
+    void setBuffer(uint8_t* buffer, uint32_t size); // nullptr disables
+    bool isEnabled()
+    {
+      return (0 != _buffer);
+    };
+    void begin(uint16_t pages); // clears the commands, sets overflow if the page table doesn't fit
+    void add(uint8_t command, uint16_t first_page, uint16_t last_page, const void* data, uint16_t size);
+    bool overflow()
+    {
+      return _overflow;
+    };
+    // commands of page: for (uint32_t i = first(page); i < end(page); i = next(i)) if (get(i, page, &data, sizeof(data))) ...
+    uint32_t first(uint16_t page);
+    uint32_t end(uint16_t page);
+    uint32_t next(uint32_t index);
+    // command code if the command at index intersects page, data copied, the part not stored is zeroed; -1 else
+    int16_t get(uint32_t index, uint16_t page, void* data, uint16_t size);
+  private:
+    static uint16_t _dataSize(uint8_t command);
+  private:
+    uint8_t* _buffer;
+    uint32_t _size, _used;
+    uint32_t* _table; // first and end offset for each page
+    uint16_t _pages;
+    bool _overflow;
+};
+
+#endif
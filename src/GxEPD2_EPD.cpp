@@ -32,6 +32,21 @@ GxEPD2_EPD::GxEPD2_EPD(int16_t cs, int16_t dc, int16_t rst, int16_t busy, int16_
   _reset_duration = 10;
   _busy_callback = 0;
   _busy_callback_parameter = 0;
+  _pAsyncSPI = 0;
+  _async_buffer = 0;
+  _async_buffer_size = 0;
+  _async_fill = 0;
+  _async_index = 0;
+  _async_transfer_active = false;
+  _async_transfer_pending = false;
+  _transfer_callback = 0;
+  _transfer_callback_parameter = 0;
+  _defer_busy_wait = false;
+  _busy_wait_pending = false;
+  _busy_wait_comment = 0;
+  _busy_wait_time = 0;
+  _busy_wait_start = 0;
+  resetStatistics();
 }
 
 void GxEPD2_EPD::init(uint32_t serial_diag_bitrate)
@@ -88,6 +103,7 @@ void GxEPD2_EPD::init(uint32_t serial_diag_bitrate, bool initial, uint16_t reset
 
 void GxEPD2_EPD::end()
 {
+  _awaitAsync();
   _pSPIx->end();
   if (_cs >= 0) pinMode(_cs, INPUT);
   if (_dc >= 0) pinMode(_dc, INPUT);
@@ -102,12 +118,53 @@ void GxEPD2_EPD::setBusyCallback(void (*busyCallback)(const void*), const void*
 
 void GxEPD2_EPD::selectSPI(SPIClass& spi, SPISettings spi_settings)
 {
+  _awaitAsync();
   _pSPIx = &spi;
   _spi_settings = spi_settings;
 }
 
+void GxEPD2_EPD::selectAsyncTransfer(GxEPD2_AsyncSPI* async_spi, uint8_t* staging_buffer, uint16_t staging_buffer_size)
+{
+  _awaitAsync();
+  bool usable = async_spi && staging_buffer && (staging_buffer_size >= 2);
+  _pAsyncSPI = usable ? async_spi : 0;
+  _async_buffer = usable ? staging_buffer : 0;
+  _async_buffer_size = usable ? staging_buffer_size : 0;
+  _async_fill = 0;
+  _async_index = 0;
+}
+
+bool GxEPD2_EPD::isTransferBusy()
+{
+  return _async_transfer_pending && ((_async_fill > 0) || (_pAsyncSPI->pending() > 0));
+}
+
+void GxEPD2_EPD::awaitTransfer()
+{
+  if (!_async_transfer_pending) return;
+  _queueAsync(); // rest of an unfinished transfer
+  while (_pAsyncSPI->pending() > 0)
+  {
+#if defined(ESP8266) || defined(ESP32)
+    yield(); // avoid wdt
+#endif
+  }
+  _async_transfer_active = false;
+  _async_transfer_pending = false;
+  if (_cs >= 0) digitalWrite(_cs, HIGH);
+  _pSPIx->endTransaction();
+  if (_transfer_callback) _transfer_callback(_transfer_callback_parameter);
+}
+
+void GxEPD2_EPD::setTransferCallback(void (*transferCallback)(const void*), const void* transfer_callback_parameter)
+{
+  _transfer_callback = transferCallback;
+  _transfer_callback_parameter = transfer_callback_parameter;
+}
+
 void GxEPD2_EPD::_reset()
 {
+  _awaitAsync();
   if (_rst >= 0)
   {
     if (_pulldown_rst_mode)
@@ -130,12 +187,99 @@ void GxEPD2_EPD::_reset()
       digitalWrite(_rst, HIGH);
       delay(_reset_duration > 10 ? _reset_duration : 10);
     }
+    _countReset();
     _hibernating = false;
   }
 }
 
+void GxEPD2_EPD::refreshAsync(bool partial_update_mode)
+{
+  _defer_busy_wait = true;
+  refresh(partial_update_mode);
+  _defer_busy_wait = false;
+}
+
+void GxEPD2_EPD::refreshAsync(int16_t x, int16_t y, int16_t w, int16_t h)
+{
+  _defer_busy_wait = true;
+  refresh(x, y, w, h);
+  _defer_busy_wait = false;
+}
+
+void GxEPD2_EPD::powerOffAsync()
+{
+  _defer_busy_wait = true;
+  powerOff();
+  _defer_busy_wait = false;
+}
+
+bool GxEPD2_EPD::isBusy()
+{
+  if (!_busy_wait_pending) return false;
+  unsigned long elapsed = micros() - _busy_wait_start;
+  if (_busy >= 0) return (digitalRead(_busy) == _busy_level) && (elapsed <= _busy_timeout);
+  return elapsed < 1000ul * _busy_wait_time;
+}
+
+bool GxEPD2_EPD::poll()
+{
+  if (!_busy_wait_pending) return false;
+  if (isBusy()) return true;
+  _endBusyWait();
+  return false;
+}
+
+void GxEPD2_EPD::awaitRefresh()
+{
+  while (poll())
+  {
+    if (_busy_callback) _busy_callback(_busy_callback_parameter);
+    else delay(1);
+#if defined(ESP8266) || defined(ESP32)
+    yield(); // avoid wdt
+#endif
+  }
+}
+
+void GxEPD2_EPD::_endBusyWait()
+{
+  unsigned long elapsed = micros() - _busy_wait_start;
+  _busy_wait_pending = false;
+  _countBusy(_busy_wait_comment, elapsed);
+  if (_busy < 0) return;
+  if (elapsed > _busy_timeout)
+  {
+    Serial.println("Busy Timeout!");
+  }
+  if (_busy_wait_comment)
+  {
+#if !defined(DISABLE_DIAGNOSTIC_OUTPUT)
+    if (_diag_enabled)
+    {
+      Serial.print(_busy_wait_comment);
+      Serial.print(" : ");
+      Serial.println(elapsed);
+    }
+#endif
+  }
+}
+
 void GxEPD2_EPD::_waitWhileBusy(const char* comment, uint16_t busy_time)
 {
+  _awaitAsync();
+#if defined(GxEPD2_HOST)
+  GxEPD2_HostBusyPhase(_busy, _busy_level, busy_time); // host panel model, see extras/host
+#endif
+  if (_defer_busy_wait)
+  {
+    // the last busy phase started by refreshAsync() or powerOffAsync() is completed by poll() or awaitRefresh()
+    if (_busy >= 0) delay(1); // add some margin to become active
+    _busy_wait_comment = comment;
+    _busy_wait_time = busy_time;
+    _busy_wait_start = micros();
+    _busy_wait_pending = true;
+    return;
+  }
   if (_busy >= 0)
   {
     delay(1); // add some margin to become active
@@ -155,6 +299,7 @@ void GxEPD2_EPD::_waitWhileBusy(const char* comment, uint16_t busy_time)
       yield(); // avoid wdt
 #endif
     }
+    _countBusy(comment, micros() - start);
     if (comment)
     {
 #if !defined(DISABLE_DIAGNOSTIC_OUTPUT)
@@ -169,11 +314,16 @@ void GxEPD2_EPD::_waitWhileBusy(const char* comment, uint16_t busy_time)
     }
     (void) start;
   }
-  else delay(busy_time);
+  else
+  {
+    delay(busy_time);
+    _countBusy(comment, 1000ul * busy_time);
+  }
 }
 
 void GxEPD2_EPD::_writeCommand(uint8_t c)
 {
+  _awaitAsync();
   _pSPIx->beginTransaction(_spi_settings);
   if (_dc >= 0) digitalWrite(_dc, LOW);
   if (_cs >= 0) digitalWrite(_cs, LOW);
@@ -181,54 +331,58 @@ void GxEPD2_EPD::_writeCommand(uint8_t c)
   if (_cs >= 0) digitalWrite(_cs, HIGH);
   if (_dc >= 0) digitalWrite(_dc, HIGH);
   _pSPIx->endTransaction();
+  _countTransaction();
+  _countCommand(c);
 }
 
 void GxEPD2_EPD::_writeData(uint8_t d)
 {
+  _awaitAsync();
   _pSPIx->beginTransaction(_spi_settings);
   if (_cs >= 0) digitalWrite(_cs, LOW);
   _pSPIx->transfer(d);
   if (_cs >= 0) digitalWrite(_cs, HIGH);
   _pSPIx->endTransaction();
+  _countTransaction();
+  _countData(1);
 }
 
 void GxEPD2_EPD::_writeData(const uint8_t* data, uint16_t n)
 {
+  _awaitAsync();
   _pSPIx->beginTransaction(_spi_settings);
   if (_cs >= 0) digitalWrite(_cs, LOW);
-  for (uint16_t i = 0; i < n; i++)
-  {
-    _pSPIx->transfer(*data++);
-  }
+  _transferRow(*_pSPIx, data, n);
   if (_cs >= 0) digitalWrite(_cs, HIGH);
   _pSPIx->endTransaction();
+  _countTransaction();
+  _countData(n);
 }
 
 void GxEPD2_EPD::_writeDataPGM(const uint8_t* data, uint16_t n, int16_t fill_with_zeroes)
 {
+  _awaitAsync();
   _pSPIx->beginTransaction(_spi_settings);
   if (_cs >= 0) digitalWrite(_cs, LOW);
-  for (uint16_t i = 0; i < n; i++)
-  {
-    _pSPIx->transfer(pgm_read_byte(&*data++));
-  }
-  while (fill_with_zeroes > 0)
-  {
-    _pSPIx->transfer(0x00);
-    fill_with_zeroes--;
-  }
+  _transferRow(*_pSPIx, data, n, false, true);
+  if (fill_with_zeroes > 0) _transferFill(*_pSPIx, 0x00, fill_with_zeroes);
   if (_cs >= 0) digitalWrite(_cs, HIGH);
   _pSPIx->endTransaction();
+  _countTransaction();
+  _countData(n + (fill_with_zeroes > 0 ? fill_with_zeroes : 0));
 }
 
 void GxEPD2_EPD::_writeDataPGM_sCS(const uint8_t* data, uint16_t n, int16_t fill_with_zeroes)
 {
+  _awaitAsync();
   _pSPIx->beginTransaction(_spi_settings);
+  _countTransaction(n + (fill_with_zeroes > 0 ? fill_with_zeroes : 0));
   for (uint8_t i = 0; i < n; i++)
   {
     if (_cs >= 0) digitalWrite(_cs, LOW);
     _pSPIx->transfer(pgm_read_byte(&*data++));
     if (_cs >= 0) digitalWrite(_cs, HIGH);
+    _countData(1);
   }
   while (fill_with_zeroes > 0)
   {
@@ -236,17 +390,22 @@ void GxEPD2_EPD::_writeDataPGM_sCS(const uint8_t* data, uint16_t n, int16_t fill
     _pSPIx->transfer(0x00);
     fill_with_zeroes--;
     if (_cs >= 0) digitalWrite(_cs, HIGH);
+    _countData(1);
   }
   _pSPIx->endTransaction();
 }
 
 void GxEPD2_EPD::_writeCommandData(const uint8_t* pCommandData, uint8_t datalen)
 {
+  _awaitAsync();
   _pSPIx->beginTransaction(_spi_settings);
   if (_dc >= 0) digitalWrite(_dc, LOW);
   if (_cs >= 0) digitalWrite(_cs, LOW);
+  _countTransaction();
+  _countCommand(*pCommandData);
   _pSPIx->transfer(*pCommandData++);
   if (_dc >= 0) digitalWrite(_dc, HIGH);
+  _countData(datalen > 0 ? datalen - 1 : 0);
   for (uint8_t i = 0; i < datalen - 1; i++)  // sub the command
   {
     _pSPIx->transfer(*pCommandData++);
@@ -257,11 +416,15 @@ void GxEPD2_EPD::_writeCommandData(const uint8_t* pCommandData, uint8_t datalen)
 
 void GxEPD2_EPD::_writeCommandDataPGM(const uint8_t* pCommandData, uint8_t datalen)
 {
+  _awaitAsync();
   _pSPIx->beginTransaction(_spi_settings);
   if (_dc >= 0) digitalWrite(_dc, LOW);
   if (_cs >= 0) digitalWrite(_cs, LOW);
+  _countTransaction();
+  _countCommand(pgm_read_byte(&*pCommandData));
   _pSPIx->transfer(pgm_read_byte(&*pCommandData++));
   if (_dc >= 0) digitalWrite(_dc, HIGH);
+  _countData(datalen > 0 ? datalen - 1 : 0);
   for (uint8_t i = 0; i < datalen - 1; i++)  // sub the command
   {
     _pSPIx->transfer(pgm_read_byte(&*pCommandData++));
@@ -272,17 +435,272 @@ void GxEPD2_EPD::_writeCommandDataPGM(const uint8_t* pCommandData, uint8_t datal
 
 void GxEPD2_EPD::_startTransfer()
 {
+  _awaitAsync();
   _pSPIx->beginTransaction(_spi_settings);
   if (_cs >= 0) digitalWrite(_cs, LOW);
+  _countTransaction();
+  if (_pAsyncSPI)
+  {
+    _async_transfer_active = true;
+    _async_transfer_pending = true;
+  }
 }
 
 void GxEPD2_EPD::_transfer(uint8_t value)
 {
-  _pSPIx->transfer(value);
+  _countData(1);
+  if (_async_transfer_active) _stageAsync(&value, 1, false, false, false);
+  else _pSPIx->transfer(value);
+}
+
+void GxEPD2_EPD::_transferRow(const uint8_t* data, uint32_t n, bool invert, bool pgm)
+{
+  _countData(n);
+  if (_async_transfer_active) _stageAsync(data, n, invert, pgm, false);
+  else _transferRow(*_pSPIx, data, n, invert, pgm);
+}
+
+void GxEPD2_EPD::_transferFill(uint8_t value, uint32_t n)
+{
+  _countData(n);
+  if (_async_transfer_active) _stageAsync(&value, n, false, false, true);
+  else _transferFill(*_pSPIx, value, n);
 }
 
 void GxEPD2_EPD::_endTransfer()
 {
+  if (_async_transfer_active)
+  {
+    // queue the rest, CS stays active until completion, see awaitTransfer()
+    _queueAsync();
+    _async_transfer_active = false;
+    return;
+  }
   if (_cs >= 0) digitalWrite(_cs, HIGH);
   _pSPIx->endTransaction();
 }
+
+void GxEPD2_EPD::_stageAsync(const uint8_t* data, uint32_t n, bool invert, bool pgm, bool fill)
+{
+  uint16_t half = _async_buffer_size / 2;
+  while (n > 0)
+  {
+    uint8_t* buffer = _async_buffer + _async_index * half;
+    if (0 == _async_fill)
+    {
+      // this half is free if at most the other half is still queued
+      while (_pAsyncSPI->pending() > 1)
+      {
+#if defined(ESP8266) || defined(ESP32)
+        yield(); // avoid wdt
+#endif
+      }
+    }
+    uint16_t chunk = n < uint32_t(half - _async_fill) ? n : half - _async_fill;
+    for (uint16_t i = 0; i < chunk; i++)
+    {
+      uint16_t j = fill ? 0 : i;
+#if defined(__AVR) || defined(ESP8266) || defined(ESP32)
+      uint8_t d = pgm ? pgm_read_byte(&data[j]) : data[j];
+#else
+      uint8_t d = data[j];
+#endif
+      buffer[_async_fill + i] = invert ? ~d : d;
+    }
+    if (!fill) data += chunk;
+    _async_fill += chunk;
+    n -= chunk;
+    if (_async_fill == half) _queueAsync();
+  }
+}
+
+void GxEPD2_EPD::_queueAsync()
+{
+  if (0 == _async_fill) return;
+  uint8_t* buffer = _async_buffer + _async_index * (_async_buffer_size / 2);
+  while (!_pAsyncSPI->queue(buffer, _async_fill))
+  {
+#if defined(ESP8266) || defined(ESP32)
+    yield(); // avoid wdt
+#endif
+  }
+  _async_index ^= 1;
+  _async_fill = 0;
+}
+
+void GxEPD2_EPD::_transferRow(SPIClass& spi, const uint8_t* data, uint32_t n, bool invert, bool pgm)
+{
+#if defined(ESP8266) || defined(ESP32)
+  if (!invert && !pgm)
+  {
+    spi.writeBytes(data, n); // send from source, keeps the SPI FIFO filled
+    return;
+  }
+#endif
+  uint8_t buffer[GxEPD2_TRANSFER_CHUNK_SIZE];
+  while (n > 0)
+  {
+    uint16_t chunk = n < sizeof(buffer) ? n : sizeof(buffer);
+    for (uint16_t i = 0; i < chunk; i++)
+    {
+#if defined(__AVR) || defined(ESP8266) || defined(ESP32)
+      uint8_t d = pgm ? pgm_read_byte(&data[i]) : data[i];
+#else
+      uint8_t d = data[i];
+#endif
+      buffer[i] = invert ? ~d : d;
+    }
+#if defined(ESP8266) || defined(ESP32)
+    spi.writeBytes(buffer, chunk);
+#else
+    spi.transfer(buffer, chunk); // received data overwrites buffer
+#endif
+    data += chunk;
+    n -= chunk;
+  }
+}
+
+void GxEPD2_EPD::_transferFill(SPIClass& spi, uint8_t value, uint32_t n)
+{
+#if defined(ESP8266) || defined(ESP32)
+  spi.writePattern(&value, 1, n);
+#else
+  uint8_t buffer[GxEPD2_TRANSFER_CHUNK_SIZE];
+  while (n > 0)
+  {
+    uint16_t chunk = n < sizeof(buffer) ? n : sizeof(buffer);
+    memset(buffer, value, chunk); // refill, received data overwrites buffer
+    spi.transfer(buffer, chunk);
+    n -= chunk;
+  }
+#endif
+}
+
+GxEPD2_EPD::Statistics GxEPD2_EPD::getStatistics()
+{
+#if ENABLE_GxEPD2_STATISTICS
+  return _statistics;
+#else
+  Statistics statistics;
+  memset(&statistics, 0, sizeof(statistics));
+  return statistics;
+#endif
+}
+
+void GxEPD2_EPD::resetStatistics()
+{
+#if ENABLE_GxEPD2_STATISTICS
+  memset(&_statistics, 0, sizeof(_statistics));
+  _trace_index = 0;
+  _trace_count = 0;
+#endif
+}
+
+void GxEPD2_EPD::printStatistics(Print& out)
+{
+#if ENABLE_GxEPD2_STATISTICS
+  out.print("commands "); out.print(_statistics.commands);
+  out.print(", data bytes "); out.print(_statistics.data_bytes);
+  out.print(", transactions "); out.print(_statistics.transactions);
+  out.print(", CS "); out.print(_statistics.cs_activations);
+  out.print(", resets "); out.println(_statistics.resets);
+  out.print("busy waits "); out.print(_statistics.busy_waits);
+  out.print(" : "); out.print(_statistics.busy_time); out.println(" us");
+  for (uint8_t i = 0; i < _statistics.phase_count; i++)
+  {
+    const Statistics::Phase& phase = _statistics.phases[i];
+    out.print("  "); out.print(phase.comment ? phase.comment : "-");
+    out.print(" : "); out.print(phase.count);
+    out.print(" x, "); out.print(phase.time);
+    out.print(" us, max "); out.print(phase.max_time); out.println(" us");
+  }
+#endif
+}
+
+void GxEPD2_EPD::printTrace(Print& out)
+{
+#if ENABLE_GxEPD2_STATISTICS && (GxEPD2_STATISTICS_TRACE_SIZE > 0)
+  uint16_t n = _trace_count < GxEPD2_STATISTICS_TRACE_SIZE ? _trace_count : GxEPD2_STATISTICS_TRACE_SIZE;
+  if (_trace_count > n)
+  {
+    out.print("... "); out.print(_trace_count - n); out.println(" entries overwritten");
+  }
+  for (uint16_t i = 0; i < n; i++)
+  {
+    const TraceEntry& entry = _trace[(_trace_index + GxEPD2_STATISTICS_TRACE_SIZE - n + i) % GxEPD2_STATISTICS_TRACE_SIZE];
+    out.print(entry.time);
+    switch (entry.type)
+    {
+      case TraceCommand:
+        out.print(" command 0x");
+        if (entry.value < 0x10) out.print("0");
+        out.println(entry.value, HEX);
+        break;
+      case TraceData:
+        out.print(" data "); out.println(entry.value);
+        break;
+      case TraceBusy:
+        out.print(" busy "); out.print(entry.comment ? entry.comment : "-");
+        out.print(" : "); out.print(entry.value); out.println(" us");
+        break;
+      case TraceReset:
+        out.println(" reset");
+        break;
+    }
+  }
+#endif
+}
+
+#if ENABLE_GxEPD2_STATISTICS
+
+void GxEPD2_EPD::_traceEvent(TraceType type, uint32_t value, const char* comment)
+{
+#if GxEPD2_STATISTICS_TRACE_SIZE > 0
+  if ((TraceData == type) && (0 == value)) return;
+  if ((TraceData == type) && (_trace_count > 0))
+  {
+    // consecutive data bytes, e.g. rows of an image, are combined
+    TraceEntry& last = _trace[(_trace_index + GxEPD2_STATISTICS_TRACE_SIZE - 1) % GxEPD2_STATISTICS_TRACE_SIZE];
+    if (TraceData == last.type)
+    {
+      last.value += value;
+      return;
+    }
+  }
+  TraceEntry& entry = _trace[_trace_index];
+  entry.time = micros();
+  if (TraceBusy == type) entry.time -= value;
+  entry.value = value;
+  entry.comment = comment;
+  entry.type = type;
+  _trace_index = (_trace_index + 1) % GxEPD2_STATISTICS_TRACE_SIZE;
+  if (_trace_count < 0xFFFF) _trace_count++;
+#endif
+}
+
+void GxEPD2_EPD::_recordBusy(const char* comment, uint32_t elapsed)
+{
+  _statistics.busy_waits++;
+  _statistics.busy_time += elapsed;
+  uint8_t i = 0;
+  for (; i < _statistics.phase_count; i++)
+  {
+    const char* c = _statistics.phases[i].comment;
+    if ((c == comment) || (c && comment && (0 == strcmp(c, comment)))) break;
+  }
+  if ((i == _statistics.phase_count) && (i < GxEPD2_STATISTICS_PHASES))
+  {
+    _statistics.phases[i].comment = comment;
+    _statistics.phase_count++;
+  }
+  if (i < GxEPD2_STATISTICS_PHASES) // else no more place
+  {
+    Statistics::Phase& phase = _statistics.phases[i];
+    phase.count++;
+    phase.time += elapsed;
+    if (elapsed > phase.max_time) phase.max_time = elapsed;
+  }
+  _traceEvent(TraceBusy, elapsed, comment);
+}
+
+#endif
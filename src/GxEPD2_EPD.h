@@ -16,10 +16,32 @@
 #include <SPI.h>
 
 #include <GxEPD2.h>
+#include "GxEPD2_AsyncSPI.h"
 
 #pragma GCC diagnostic ignored "-Wunused-parameter"
 //#pragma GCC diagnostic ignored "-Wsign-compare"
 
+// size of the stack buffer used to stage rows for block transfer, where the SPI class can't send from source directly
+#ifndef GxEPD2_TRANSFER_CHUNK_SIZE
+#define GxEPD2_TRANSFER_CHUNK_SIZE 32
+#endif
+
+// SPI traffic statistics and trace for measurements, see getStatistics(); default is off, costs nothing if off
+// must be the same for the library and the sketch, e.g. set with build flags
+#ifndef ENABLE_GxEPD2_STATISTICS
+#define ENABLE_GxEPD2_STATISTICS 0
+#endif
+
+// number of busy phases counted separately, by the comment of _waitWhileBusy()
+#ifndef GxEPD2_STATISTICS_PHASES
+#define GxEPD2_STATISTICS_PHASES 8
+#endif
+
+// number of trace entries kept, the oldest are overwritten; 0 : no trace
+#ifndef GxEPD2_STATISTICS_TRACE_SIZE
+#define GxEPD2_STATISTICS_TRACE_SIZE 32
+#endif
+
 class GxEPD2_EPD
 {
   public:
@@ -30,6 +52,9 @@ class GxEPD2_EPD
     const bool hasColor;
     const bool hasPartialUpdate;
     const bool hasFastPartialUpdate;
+    // differential update: controller takes the new image as previous image on refresh (e.g. N2OCP, or single image buffer),
+    // writeImageAgain() and the second phase of paged drawing are not needed; drivers that do this declare it true
+    static const bool hasPreviousImageSync = false;
     // constructor
     GxEPD2_EPD(int16_t cs, int16_t dc, int16_t rst, int16_t busy, int16_t busy_level, uint32_t busy_timeout,
                uint16_t w, uint16_t h, GxEPD2::Panel p, bool c, bool pu, bool fpu);
@@ -100,6 +125,62 @@ class GxEPD2_EPD
       return (a > b ? a : b);
     };
     void selectSPI(SPIClass& spi, SPISettings spi_settings);
+    // optional asynchronous image upload: rows are staged alternately into the two halves of staging_buffer
+    // and queued to async_spi; the data phase of a transfer continues after writeImage() returns,
+    // e.g. while the next page is drawn. staging_buffer must be suitable for the backend (e.g. DMA capable).
+    // the SPI transaction and CS stay active until awaitTransfer(): call it before any other use of the SPI bus,
+    // e.g. SD card or sensor; on ESP32 another beginTransaction() in the same task would deadlock (bus lock not recursive)
+    // async_spi = 0 : disabled (default)
+    void selectAsyncTransfer(GxEPD2_AsyncSPI* async_spi, uint8_t* staging_buffer, uint16_t staging_buffer_size);
+    // true while queued data of an asynchronous transfer is not yet sent
+    bool isTransferBusy();
+    // wait for completion of an asynchronous transfer, and end it; done implicitly by any following SPI access
+    void awaitTransfer();
+    // register a callback function to be called when an asynchronous transfer has been completed
+    void setTransferCallback(void (*transferCallback)(const void*), const void* transfer_callback_parameter = 0);
+    // non-blocking refresh: starts the refresh and returns without waiting for the panel to become ready;
+    // any following command to the controller waits for completion, or use poll() or awaitRefresh()
+    // drivers that wait on their own (e.g. GxEPD2_1248) refresh synchronously
+    void refreshAsync(bool partial_update_mode = false);
+    void refreshAsync(int16_t x, int16_t y, int16_t w, int16_t h);
+    void powerOffAsync();
+    // true while the panel is busy with a refresh or powerOff started asynchronously
+    bool isBusy();
+    // completes the asynchronous refresh if the panel is no longer busy; returns true while busy
+    bool poll();
+    // waits for completion of the asynchronous refresh, calls the busy callback while waiting
+    void awaitRefresh();
+    // SPI traffic statistics, counted if ENABLE_GxEPD2_STATISTICS, else all zero
+    struct Statistics
+    {
+      uint32_t commands; // command bytes (DC LOW)
+      uint32_t data_bytes; // data bytes (DC HIGH), single and block transfers
+      uint32_t transactions; // SPI transactions (beginTransaction)
+      uint32_t cs_activations; // CS LOW
+      uint32_t resets;
+      uint32_t busy_waits;
+      uint32_t busy_time; // µs, of all busy waits
+      struct Phase
+      {
+        const char* comment; // as passed to _waitWhileBusy(), 0 for busy waits without comment
+        uint16_t count;
+        uint32_t time; // µs, sum
+        uint32_t max_time; // µs
+      } phases[GxEPD2_STATISTICS_PHASES]; // in order of first occurrence, further comments are only in busy_time
+      uint8_t phase_count;
+    };
+    enum TraceType {TraceCommand, TraceData, TraceBusy, TraceReset};
+    struct TraceEntry
+    {
+      uint32_t time; // micros() at start
+      uint32_t value; // command, number of data bytes, or µs busy
+      const char* comment; // of busy wait
+      TraceType type;
+    };
+    Statistics getStatistics(); // snapshot
+    void resetStatistics(); // clears statistics and trace
+    void printStatistics(Print& out = Serial);
+    void printTrace(Print& out = Serial); // oldest first, consecutive data bytes are combined
   protected:
     void _reset();
     void _waitWhileBusy(const char* comment = 0, uint16_t busy_time = 5000);
@@ -112,7 +193,64 @@ class GxEPD2_EPD
     void _writeCommandDataPGM(const uint8_t* pCommandData, uint8_t datalen);
     void _startTransfer();
     void _transfer(uint8_t value);
+    // block transfer of n bytes, optionally inverted, from RAM or PROGMEM, to be called between _startTransfer() and _endTransfer()
+    void _transferRow(const uint8_t* data, uint32_t n, bool invert = false, bool pgm = false);
+    // block transfer of n bytes of same value, to be called between _startTransfer() and _endTransfer()
+    void _transferFill(uint8_t value, uint32_t n);
     void _endTransfer();
+    // block transfer methods for classes that handle their own SPI transactions, e.g. GxEPD2_1248::ScreenPart
+    static void _transferRow(SPIClass& spi, const uint8_t* data, uint32_t n, bool invert = false, bool pgm = false);
+    static void _transferFill(SPIClass& spi, uint8_t value, uint32_t n);
+    // complete a pending asynchronous transfer or refresh, needed before any other use of SPI, CS, DC or RST
+    void _awaitAsync()
+    {
+      if (_async_transfer_pending) awaitTransfer();
+      if (_busy_wait_pending) awaitRefresh();
+    };
+    // statistics counting, empty if !ENABLE_GxEPD2_STATISTICS
+    void _countTransaction(uint32_t cs_activations = 1)
+    {
+#if ENABLE_GxEPD2_STATISTICS
+      _statistics.transactions++;
+      if (_cs >= 0) _statistics.cs_activations += cs_activations;
+#endif
+    };
+    void _countCommand(uint8_t c)
+    {
+#if ENABLE_GxEPD2_STATISTICS
+      _statistics.commands++;
+      _traceEvent(TraceCommand, c);
+#endif
+    };
+    void _countData(uint32_t n)
+    {
+#if ENABLE_GxEPD2_STATISTICS
+      _statistics.data_bytes += n;
+      _traceEvent(TraceData, n);
+#endif
+    };
+    void _countReset()
+    {
+#if ENABLE_GxEPD2_STATISTICS
+      _statistics.resets++;
+      _traceEvent(TraceReset, 0);
+#endif
+    };
+    // for classes that wait on their own, e.g. GxEPD2_1248
+    void _countBusy(const char* comment, uint32_t elapsed)
+    {
+#if ENABLE_GxEPD2_STATISTICS
+      _recordBusy(comment, elapsed);
+#endif
+    };
+  private:
+    void _stageAsync(const uint8_t* data, uint32_t n, bool invert, bool pgm, bool fill);
+    void _queueAsync();
+    void _endBusyWait();
+#if ENABLE_GxEPD2_STATISTICS
+    void _traceEvent(TraceType type, uint32_t value, const char* comment = 0);
+    void _recordBusy(const char* comment, uint32_t elapsed);
+#endif
   protected:
     int16_t _cs, _dc, _rst, _busy, _busy_level;
     uint32_t _busy_timeout;
@@ -125,6 +263,24 @@ class GxEPD2_EPD
     uint16_t _reset_duration;
     void (*_busy_callback)(const void*); 
     const void* _busy_callback_parameter;
+    GxEPD2_AsyncSPI* _pAsyncSPI;
+    uint8_t* _async_buffer;
+    uint16_t _async_buffer_size, _async_fill;
+    uint8_t _async_index;
+    bool _async_transfer_active, _async_transfer_pending;
+    void (*_transfer_callback)(const void*);
+    const void* _transfer_callback_parameter;
+    bool _defer_busy_wait, _busy_wait_pending;
+    const char* _busy_wait_comment;
+    uint16_t _busy_wait_time;
+    unsigned long _busy_wait_start;
+#if ENABLE_GxEPD2_STATISTICS
+    Statistics _statistics;
+#if GxEPD2_STATISTICS_TRACE_SIZE > 0
+    TraceEntry _trace[GxEPD2_STATISTICS_TRACE_SIZE];
+#endif
+    uint16_t _trace_index, _trace_count;
+#endif
 };
 
 #endif
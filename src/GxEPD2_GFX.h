@@ -31,6 +31,7 @@ class GxEPD2_GFX : public GxEPD2_GFX_ROOT_CLASS
     virtual uint16_t pages() = 0;
     virtual uint16_t pageHeight() = 0;
     virtual bool mirror(bool m) = 0;
+    virtual void setDisplayList(uint8_t* buffer, uint32_t size) = 0; // optional, for paged drawing
     virtual void init(uint32_t serial_diag_bitrate = 0) = 0; // serial_diag_bitrate = 0 : disabled
     // init method with additional parameters:
     // initial false for re-init after processor deep sleep wake up, if display power supply was kept
@@ -48,6 +49,8 @@ class GxEPD2_GFX : public GxEPD2_GFX_ROOT_CLASS
     // else window is increased as needed,
     // this is an addressing limitation of the e-paper controllers
     virtual void displayWindow(uint16_t x, uint16_t y, uint16_t w, uint16_t h) = 0;
+    // display the changed part of buffer content to screen, with partial refresh, useful for full screen buffer
+    virtual void displayChanged() = 0;
     virtual void setFullWindow() = 0;
     // setPartialWindow, use parameters according to actual rotation.
     // x and w should be multiple of 8, for rotation 0 or 2,
@@ -57,6 +60,14 @@ class GxEPD2_GFX : public GxEPD2_GFX_ROOT_CLASS
     virtual void setPartialWindow(uint16_t x, uint16_t y, uint16_t w, uint16_t h) = 0;
     virtual void firstPage() = 0;
     virtual bool nextPage() = 0;
+    // non-blocking variants, the steps after the refresh are done by poll() or awaitRefresh()
+    virtual void displayAsync(bool partial_update_mode = false) = 0;
+    virtual void displayWindowAsync(uint16_t x, uint16_t y, uint16_t w, uint16_t h) = 0;
+    virtual void displayChangedAsync() = 0;
+    virtual bool nextPageAsync() = 0;
+    virtual bool isBusy() = 0; // true while an asynchronous refresh is not completed
+    virtual bool poll() = 0; // returns true while busy
+    virtual void awaitRefresh() = 0;
     virtual void drawPaged(void (*drawCallback)(const void*), const void* pv) = 0;
     virtual void drawInvertedBitmap(int16_t x, int16_t y, const uint8_t bitmap[], int16_t w, int16_t h, uint16_t color) = 0;
     //  Support for Bitmaps (Sprites) to Controller Buffer and to Screen
@@ -88,6 +99,8 @@ class GxEPD2_GFX : public GxEPD2_GFX_ROOT_CLASS
     virtual void drawNative(const uint8_t* data1, const uint8_t* data2, int16_t x, int16_t y, int16_t w, int16_t h, bool invert = false, bool mirror_y = false, bool pgm = false) = 0;
     virtual void refresh(bool partial_update_mode = false) = 0; // screen refresh from controller memory to full screen
     virtual void refresh(int16_t x, int16_t y, int16_t w, int16_t h) = 0; // screen refresh from controller memory, partial screen
+    virtual void refreshAsync(bool partial_update_mode = false) = 0; // non-blocking refresh, see displayAsync()
+    virtual void refreshAsync(int16_t x, int16_t y, int16_t w, int16_t h) = 0;
     virtual void powerOff() = 0; // turns off generation of panel driving voltages, avoids screen fading over time
     virtual void hibernate() = 0; // turns powerOff() and sets controller to deep sleep for minimum power use, ONLY if wakeable by RST (rst >= 0)
   public:
@@ -0,0 +1,107 @@
+// Display Library for SPI e-paper panels from Dalian Good Display and boards from Waveshare.
+// Requires HW SPI and Adafruit_GFX. Caution: the e-paper panels require 3.3V supply AND data lines!
+//
+// Display Library based on Demo Example from Good Display: https://www.good-display.com/companyfile/32/
+//
+// Author: Jean-Marc Zingg
+//
+// Version: see library.properties
+//
+// Library: https://github.com/ZinggJM/GxEPD2
+
+#include <Arduino.h>
+#include "GxEPD2_GlyphCache.h"
+#include <string.h>
+
+#if defined(__AVR)
+#include <avr/pgmspace.h>
+#endif
+
+#define GxEPD2_GLYPH_CACHE_SLOTS 64
+// font, character
+#define GxEPD2_GLYPH_HEADER_SIZE (sizeof(const void*) + 1)
+
+static inline uint8_t _read(const uint8_t* p)
+{
+#if defined(__AVR) || defined(ESP8266) || defined(ESP32)
+  return pgm_read_byte(p);
+#else
+  return *p;
+#endif
+}
+
+GxEPD2_GlyphCache::GxEPD2_GlyphCache() :
+  _buffer(0), _size(0), _used(0), _index(0)
+{
+}
+
+void GxEPD2_GlyphCache::setBuffer(uint8_t* buffer, uint16_t size)
+{
+  _buffer = 0;
+  _size = 0;
+  if (!buffer) return;
+  // index of uint16_t at aligned start
+  uint8_t pad = uintptr_t(buffer) & 1;
+  if (size <= pad + 2 * GxEPD2_GLYPH_CACHE_SLOTS) return;
+  _buffer = buffer + pad;
+  _size = size - pad;
+  _index = (uint16_t*)_buffer;
+  memset(_index, 0, 2 * GxEPD2_GLYPH_CACHE_SLOTS);
+  _used = 2 * GxEPD2_GLYPH_CACHE_SLOTS;
+}
+
+const uint8_t* GxEPD2_GlyphCache::find(const void* font, uint8_t c)
+{
+  if (!_buffer) return 0;
+  uint16_t offset = _index[_slot(font, c)];
+  if (!offset) return 0;
+  const uint8_t* p = _buffer + offset;
+  if ((memcmp(p, &font, sizeof(font)) != 0) || (p[sizeof(font)] != c)) return 0;
+  return p + GxEPD2_GLYPH_HEADER_SIZE;
+}
+
+const uint8_t* GxEPD2_GlyphCache::add(const void* font, uint8_t c, const uint8_t* bits, uint8_t w, uint8_t h)
+{
+  if (!_buffer) return 0;
+  uint16_t size = GxEPD2_GLYPH_HEADER_SIZE + ((w + 7) / 8) * h;
+  if (size > _size - 2 * GxEPD2_GLYPH_CACHE_SLOTS) return 0;
+  if (size > _size - _used)
+  {
+    // full: start over
+    memset(_index, 0, 2 * GxEPD2_GLYPH_CACHE_SLOTS);
+    _used = 2 * GxEPD2_GLYPH_CACHE_SLOTS;
+  }
+  uint8_t* p = _buffer + _used;
+  memcpy(p, &font, sizeof(font));
+  p[sizeof(font)] = c;
+  expand(bits, 0, w, h, p + GxEPD2_GLYPH_HEADER_SIZE);
+  _index[_slot(font, c)] = _used;
+  _used += size;
+  return p + GxEPD2_GLYPH_HEADER_SIZE;
+}
+
+void GxEPD2_GlyphCache::expand(const uint8_t* bits, uint32_t bit, uint8_t w, uint8_t rows, uint8_t* bitmap)
+{
+  uint8_t bytes = (w + 7) / 8;
+  uint8_t last = (w & 7) ? 0xFF << (8 - (w & 7)) : 0xFF; // mask of last byte of row
+  for (uint8_t j = 0; j < rows; j++)
+  {
+    for (uint8_t b = 0; b < bytes; b++)
+    {
+      // 8 bits from bit on, the second byte read only if needed
+      const uint8_t* p = bits + bit / 8;
+      uint8_t s = bit & 7;
+      uint8_t n = (b < bytes - 1) ? 8 : w - 8 * b; // bits needed
+      uint8_t v = _read(p) << s;
+      if (s + n > 8) v |= _read(p + 1) >> (8 - s);
+      bitmap[b] = (b < bytes - 1) ? v : v & last;
+      bit += n;
+    }
+    bitmap += bytes;
+  }
+}
+
+uint8_t GxEPD2_GlyphCache::_slot(const void* font, uint8_t c)
+{
+  return (c ^ (uint8_t(uintptr_t(font) >> 2) * 7)) % GxEPD2_GLYPH_CACHE_SLOTS;
+}
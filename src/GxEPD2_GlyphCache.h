@@ -0,0 +1,44 @@
+// Display Library for SPI e-paper panels from Dalian Good Display and boards from Waveshare.
+// Requires HW SPI and Adafruit_GFX. Caution: the e-paper panels require 3.3V supply AND data lines!
+//
+// Display Library based on Demo Example from Good Display: https://www.good-display.com/companyfile/32/
+//
+// Author: Jean-Marc Zingg
+//
+// Version: see library.properties
+//
+// Library: https://github.com/ZinggJM/GxEPD2
+//
+// GxEPD2_GlyphCache: GFXfont glyphs expanded to bitmaps with rows padded to whole bytes, for GxEPD2_Blit,
+// in a buffer supplied by the user. glyphs are found by font and character through a direct mapped index;
+// when the buffer is full, it is cleared and filled anew.
+
+#ifndef _GxEPD2_GlyphCache_H_
+#define _GxEPD2_GlyphCache_H_
+
+#include <stdint.h>
+
+class GxEPD2_GlyphCache
+{
+  public:
+    GxEPD2_GlyphCache();
+    void setBuffer(uint8_t* buffer, uint16_t size); // nullptr disables
+    bool isEnabled()
+    {
+      return (0 != _buffer);
+    };
+    // expanded glyph of character c of font, 0 if not cached
+    const uint8_t* find(const void* font, uint8_t c);
+    // expands and caches the glyph of w x h pixels from the packed bits of the font in program memory, 0 if it doesn't fit
+    const uint8_t* add(const void* font, uint8_t c, const uint8_t* bits, uint8_t w, uint8_t h);
+    // expands rows of w pixels from packed bits in program memory, starting at bit, to rows of whole bytes
+    static void expand(const uint8_t* bits, uint32_t bit, uint8_t w, uint8_t rows, uint8_t* bitmap);
+  private:
+    static uint8_t _slot(const void* font, uint8_t c);
+  private:
+    uint8_t* _buffer;
+    uint16_t _size, _used;
+    uint16_t* _index; // offset of glyph entry for each slot, 0 for none
+};
+
+#endif
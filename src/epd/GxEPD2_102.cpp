@@ -33,18 +33,12 @@ void GxEPD2_102::writeScreenBuffer(uint8_t value)
   {
     _writeCommand(0x10); // init old data
     _startTransfer();
-    for (uint32_t i = 0; i < uint32_t(WIDTH) * uint32_t(HEIGHT) / 8; i++)
-    {
-      _transfer(value);
-    }
+    _transferFill(value, uint32_t(WIDTH) * uint32_t(HEIGHT) / 8);
     _endTransfer();
   }
   _writeCommand(0x13);
   _startTransfer();
-  for (uint32_t i = 0; i < uint32_t(WIDTH) * uint32_t(HEIGHT) / 8; i++)
-  {
-    _transfer(value);
-  }
+  _transferFill(value, uint32_t(WIDTH) * uint32_t(HEIGHT) / 8);
   _endTransfer();
 }
 
@@ -83,26 +77,9 @@ void GxEPD2_102::_writeImage(uint8_t command, const uint8_t bitmap[], int16_t x,
   _startTransfer();
   for (int16_t i = 0; i < h1; i++)
   {
-    for (int16_t j = 0; j < w1 / 8; j++)
-    {
-      uint8_t data;
-      // use wb, h of bitmap for index!
-      int16_t idx = mirror_y ? j + dx / 8 + ((h - 1 - (i + dy))) * wb : j + dx / 8 + (i + dy) * wb;
-      if (pgm)
-      {
-#if defined(__AVR) || defined(ESP8266) || defined(ESP32)
-        data = pgm_read_byte(&bitmap[idx]);
-#else
-        data = bitmap[idx];
-#endif
-      }
-      else
-      {
-        data = bitmap[idx];
-      }
-      if (invert) data = ~data;
-      _transfer(data);
-    }
+    // use wb, h of bitmap for index!
+    uint32_t idx = mirror_y ? dx / 8 + uint32_t((h - 1 - (i + dy))) * wb : dx / 8 + uint32_t(i + dy) * wb;
+    _transferRow(&bitmap[idx], w1 / 8, invert, pgm);
   }
   _endTransfer();
   _writeCommand(0x92); // partial out
@@ -146,26 +123,9 @@ void GxEPD2_102::_writeImagePart(uint8_t command, const uint8_t bitmap[], int16_
   _startTransfer();
   for (int16_t i = 0; i < h1; i++)
   {
-    for (int16_t j = 0; j < w1 / 8; j++)
-    {
-      uint8_t data;
-      // use wb_bitmap, h_bitmap of bitmap for index!
-      int16_t idx = mirror_y ? x_part / 8 + j + dx / 8 + ((h_bitmap - 1 - (y_part + i + dy))) * wb_bitmap : x_part / 8 + j + dx / 8 + (y_part + i + dy) * wb_bitmap;
-      if (pgm)
-      {
-#if defined(__AVR) || defined(ESP8266) || defined(ESP32)
-        data = pgm_read_byte(&bitmap[idx]);
-#else
-        data = bitmap[idx];
-#endif
-      }
-      else
-      {
-        data = bitmap[idx];
-      }
-      if (invert) data = ~data;
-      _transfer(data);
-    }
+    // use wb_bitmap, h_bitmap of bitmap for index!
+    uint32_t idx = mirror_y ? x_part / 8 + dx / 8 + uint32_t((h_bitmap - 1 - (y_part + i + dy))) * wb_bitmap : x_part / 8 + dx / 8 + uint32_t(y_part + i + dy) * wb_bitmap;
+    _transferRow(&bitmap[idx], w1 / 8, invert, pgm);
   }
   _endTransfer();
   _writeCommand(0x92); // partial out
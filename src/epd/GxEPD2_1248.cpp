@@ -62,6 +62,35 @@ GxEPD2_1248::GxEPD2_1248(int16_t cs_m1, int16_t cs_s1, int16_t cs_m2, int16_t cs
 {
 }
 
+void GxEPD2_1248::selectSPI(SPIClass& spi, SPISettings spi_settings)
+{
+  selectSPI(spi, spi, spi, spi, spi_settings);
+}
+
+void GxEPD2_1248::selectSPI(SPIClass& spi_m1, SPIClass& spi_s1, SPIClass& spi_m2, SPIClass& spi_s2, SPISettings spi_settings)
+{
+  GxEPD2_EPD::selectSPI(spi_m1, spi_settings);
+  M1.selectSPI(spi_m1, spi_settings);
+  S1.selectSPI(spi_s1, spi_settings);
+  M2.selectSPI(spi_m2, spi_settings);
+  S2.selectSPI(spi_s2, spi_settings);
+}
+
+void GxEPD2_1248::selectAsyncTransfer(GxEPD2_AsyncSPI* async_spi, uint8_t* staging_buffer, uint16_t staging_buffer_size)
+{
+  selectAsyncTransfer(async_spi, async_spi, async_spi, async_spi, staging_buffer, staging_buffer_size);
+}
+
+void GxEPD2_1248::selectAsyncTransfer(GxEPD2_AsyncSPI* async_m1, GxEPD2_AsyncSPI* async_s1, GxEPD2_AsyncSPI* async_m2, GxEPD2_AsyncSPI* async_s2,
+                                      uint8_t* staging_buffer, uint16_t staging_buffer_size)
+{
+  uint16_t quarter = staging_buffer ? staging_buffer_size / 4 : 0;
+  M1.selectAsyncTransfer(async_m1, staging_buffer, quarter);
+  S1.selectAsyncTransfer(async_s1, staging_buffer + quarter, quarter);
+  M2.selectAsyncTransfer(async_m2, staging_buffer + 2 * quarter, quarter);
+  S2.selectAsyncTransfer(async_s2, staging_buffer + 3 * quarter, quarter);
+}
+
 void GxEPD2_1248::init(uint32_t serial_diag_bitrate)
 {
   init(serial_diag_bitrate, true, 20, false);
@@ -110,37 +139,22 @@ void GxEPD2_1248::clearScreen(uint8_t value)
 void GxEPD2_1248::writeScreenBuffer(uint8_t value)
 {
   if (!_using_partial_mode) _Init_Part();
-  if (_initial_write)
-  {
-    M1.writeScreenBuffer(0x10, value);
-    S1.writeScreenBuffer(0x10, value);
-    M2.writeScreenBuffer(0x10, value);
-    S2.writeScreenBuffer(0x10, value);
-  }
-  M1.writeScreenBuffer(0x13, value);
-  S1.writeScreenBuffer(0x13, value);
-  M2.writeScreenBuffer(0x13, value);
-  S2.writeScreenBuffer(0x13, value);
+  if (_initial_write) _writeScreenBufferParts(0x10, value);
+  _writeScreenBufferParts(0x13, value);
   _initial_write = false; // initial full screen buffer clean done
 }
 
 void GxEPD2_1248::writeScreenBufferAgain(uint8_t value)
 {
   if (!_using_partial_mode) _Init_Part();
-  M1.writeScreenBuffer(0x10, value);
-  S1.writeScreenBuffer(0x10, value);
-  M2.writeScreenBuffer(0x10, value);
-  S2.writeScreenBuffer(0x10, value);
+  _writeScreenBufferParts(0x10, value);
 }
 
 void GxEPD2_1248::writeImage(const uint8_t bitmap[], int16_t x, int16_t y, int16_t w, int16_t h, bool invert, bool mirror_y, bool pgm)
 {
   if (_initial_write) writeScreenBuffer(); // initial full screen buffer clean
   if (!_using_partial_mode) _Init_Part();
-  S2.writeImagePart(0x13, bitmap, 0, 0, w, h, x, y, w, h, invert, mirror_y, pgm);
-  M2.writeImagePart(0x13, bitmap, 0, 0, w, h, x - S2.WIDTH, y, w, h, invert, mirror_y, pgm);
-  M1.writeImagePart(0x13, bitmap, 0, 0, w, h, x, y - S2.HEIGHT, w, h, invert, mirror_y, pgm);
-  S1.writeImagePart(0x13, bitmap, 0, 0, w, h, x - M1.WIDTH, y - M2.HEIGHT, w, h, invert, mirror_y, pgm);
+  _writeImageParts(0x13, bitmap, 0, 0, w, h, x, y, w, h, invert, mirror_y, pgm);
 }
 
 void GxEPD2_1248::writeImagePart(const uint8_t bitmap[], int16_t x_part, int16_t y_part, int16_t w_bitmap, int16_t h_bitmap,
@@ -148,20 +162,14 @@ void GxEPD2_1248::writeImagePart(const uint8_t bitmap[], int16_t x_part, int16_t
 {
   if (_initial_write) writeScreenBuffer(); // initial full screen buffer clean
   if (!_using_partial_mode) _Init_Part();
-  S2.writeImagePart(0x13, bitmap, x_part, y_part, w, h, x, y, w, h, invert, mirror_y, pgm);
-  M2.writeImagePart(0x13, bitmap, x_part, y_part, w, h, x - S2.WIDTH, y, w, h, invert, mirror_y, pgm);
-  M1.writeImagePart(0x13, bitmap, x_part, y_part, w, h, x, y - S2.HEIGHT, w, h, invert, mirror_y, pgm);
-  S1.writeImagePart(0x13, bitmap, x_part, y_part, w, h, x - M1.WIDTH, y - M2.HEIGHT, w, h, invert, mirror_y, pgm);
+  _writeImageParts(0x13, bitmap, x_part, y_part, w_bitmap, h_bitmap, x, y, w, h, invert, mirror_y, pgm);
 }
 
 void GxEPD2_1248::writeImageAgain(const uint8_t bitmap[], int16_t x, int16_t y, int16_t w, int16_t h, bool invert, bool mirror_y, bool pgm)
 {
   if (_initial_write) writeScreenBuffer(); // initial full screen buffer clean
   if (!_using_partial_mode) _Init_Part();
-  S2.writeImagePart(0x10, bitmap, 0, 0, w, h, x, y, w, h, invert, mirror_y, pgm);
-  M2.writeImagePart(0x10, bitmap, 0, 0, w, h, x - S2.WIDTH, y, w, h, invert, mirror_y, pgm);
-  M1.writeImagePart(0x10, bitmap, 0, 0, w, h, x, y - S2.HEIGHT, w, h, invert, mirror_y, pgm);
-  S1.writeImagePart(0x10, bitmap, 0, 0, w, h, x - M1.WIDTH, y - M2.HEIGHT, w, h, invert, mirror_y, pgm);
+  _writeImageParts(0x10, bitmap, 0, 0, w, h, x, y, w, h, invert, mirror_y, pgm);
 }
 
 void GxEPD2_1248::writeImagePartAgain(const uint8_t bitmap[], int16_t x_part, int16_t y_part, int16_t w_bitmap, int16_t h_bitmap,
@@ -169,10 +177,7 @@ void GxEPD2_1248::writeImagePartAgain(const uint8_t bitmap[], int16_t x_part, in
 {
   if (_initial_write) writeScreenBuffer(); // initial full screen buffer clean
   if (!_using_partial_mode) _Init_Part();
-  S2.writeImagePart(0x10, bitmap, x_part, y_part, w, h, x, y, w, h, invert, mirror_y, pgm);
-  M2.writeImagePart(0x10, bitmap, x_part, y_part, w, h, x - S2.WIDTH, y, w, h, invert, mirror_y, pgm);
-  M1.writeImagePart(0x10, bitmap, x_part, y_part, w, h, x, y - S2.HEIGHT, w, h, invert, mirror_y, pgm);
-  S1.writeImagePart(0x10, bitmap, x_part, y_part, w, h, x - M1.WIDTH, y - M2.HEIGHT, w, h, invert, mirror_y, pgm);
+  _writeImageParts(0x10, bitmap, x_part, y_part, w_bitmap, h_bitmap, x, y, w, h, invert, mirror_y, pgm);
 }
 
 void GxEPD2_1248::writeImage(const uint8_t* black, const uint8_t* color, int16_t x, int16_t y, int16_t w, int16_t h, bool invert, bool mirror_y, bool pgm)
@@ -290,12 +295,12 @@ void GxEPD2_1248::_initSPI()
 #if defined(ESP32)
   if ((SCK != _sck) || (MISO != _miso) || (MOSI != _mosi))
   {
-    SPI.end();
-    SPI.begin(_sck, _miso, _mosi, _cs_m1);
+    _pSPIx->end();
+    _pSPIx->begin(_sck, _miso, _mosi, _cs_m1);
   }
-  else SPI.begin();
+  else _pSPIx->begin();
 #else
-  SPI.begin();
+  _pSPIx->begin();
 #endif
 }
 
@@ -514,89 +519,122 @@ void GxEPD2_1248::_Update_Part()
 
 void GxEPD2_1248::_writeCommandMaster(uint8_t c)
 {
-  SPI.beginTransaction(_spi_settings);
-  digitalWrite(_dc1, LOW);
-  digitalWrite(_dc2, LOW);
-  digitalWrite(_cs_m1, LOW);
-  digitalWrite(_cs_m2, LOW);
-  SPI.transfer(c);
-  digitalWrite(_cs_m1, HIGH);
-  digitalWrite(_cs_m2, HIGH);
-  digitalWrite(_dc1, HIGH);
-  digitalWrite(_dc2, HIGH);
-  SPI.endTransaction();
+  _writeParts(true, true, &c, 1);
 }
 
 void GxEPD2_1248::_writeDataMaster(uint8_t d)
 {
-  SPI.beginTransaction(_spi_settings);
-  digitalWrite(_cs_m1, LOW);
-  digitalWrite(_cs_m2, LOW);
-  SPI.transfer(d);
-  digitalWrite(_cs_m1, HIGH);
-  digitalWrite(_cs_m2, HIGH);
-  SPI.endTransaction();
+  _writeParts(true, false, &d, 1);
 }
 
 void GxEPD2_1248::_writeCommandAll(uint8_t c)
 {
-  SPI.beginTransaction(_spi_settings);
-  digitalWrite(_dc1, LOW);
-  digitalWrite(_dc2, LOW);
-  digitalWrite(_cs_m1, LOW);
-  digitalWrite(_cs_s1, LOW);
-  digitalWrite(_cs_m2, LOW);
-  digitalWrite(_cs_s2, LOW);
-  SPI.transfer(c);
-  digitalWrite(_cs_m1, HIGH);
-  digitalWrite(_cs_s1, HIGH);
-  digitalWrite(_cs_m2, HIGH);
-  digitalWrite(_cs_s2, HIGH);
-  digitalWrite(_dc1, HIGH);
-  digitalWrite(_dc2, HIGH);
-  SPI.endTransaction();
+  _writeParts(false, true, &c, 1);
 }
 
 void GxEPD2_1248::_writeDataAll(uint8_t d)
 {
-  SPI.beginTransaction(_spi_settings);
-  digitalWrite(_cs_m1, LOW);
-  digitalWrite(_cs_s1, LOW);
-  digitalWrite(_cs_m2, LOW);
-  digitalWrite(_cs_s2, LOW);
-  SPI.transfer(d);
-  digitalWrite(_cs_m1, HIGH);
-  digitalWrite(_cs_s1, HIGH);
-  digitalWrite(_cs_m2, HIGH);
-  digitalWrite(_cs_s2, HIGH);
-  SPI.endTransaction();
+  _writeParts(false, false, &d, 1);
 }
 
 void GxEPD2_1248::_writeDataPGM_All(const uint8_t* data, uint16_t n, int16_t fill_with_zeroes)
 {
-  SPI.beginTransaction(_spi_settings);
-  digitalWrite(_cs_m1, LOW);
-  digitalWrite(_cs_s1, LOW);
-  digitalWrite(_cs_m2, LOW);
-  digitalWrite(_cs_s2, LOW);
-  for (uint16_t i = 0; i < n; i++)
+  _writeParts(false, false, data, n, true, fill_with_zeroes);
+}
+
+// to the masters or all controllers at once, one transaction per SPI bus
+void GxEPD2_1248::_writeParts(bool masters, bool command, const uint8_t* data, uint16_t n, bool pgm, int16_t fill_with_zeroes)
+{
+  ScreenPart* parts[] = {&M1, &S1, &M2, &S2};
+  int16_t cs[] = {_cs_m1, _cs_s1, _cs_m2, _cs_s2};
+  uint8_t selected = masters ? 0x05 : 0x0F; // bit i for parts[i]
+  for (uint8_t i = 0; i < 4; i++)
+  {
+    if (!(selected & (1 << i))) continue; // not selected or done with a bus before
+    SPIClass* spi = parts[i]->bus();
+    spi->beginTransaction(_spi_settings);
+    if (command)
+    {
+      digitalWrite(_dc1, LOW);
+      digitalWrite(_dc2, LOW);
+    }
+    uint8_t on_bus = 0;
+    for (uint8_t j = i; j < 4; j++)
+    {
+      if ((selected & (1 << j)) && (parts[j]->bus() == spi)) on_bus |= 1 << j;
+    }
+    selected &= ~on_bus;
+    for (uint8_t j = i; j < 4; j++) if (on_bus & (1 << j)) digitalWrite(cs[j], LOW);
+    for (uint16_t k = 0; k < n; k++)
+    {
+      spi->transfer(pgm ? pgm_read_byte(&data[k]) : data[k]);
+    }
+    for (int16_t k = fill_with_zeroes; k > 0; k--)
+    {
+      spi->transfer(0x00);
+    }
+    for (uint8_t j = i; j < 4; j++) if (on_bus & (1 << j)) digitalWrite(cs[j], HIGH);
+    if (command)
+    {
+      digitalWrite(_dc1, HIGH);
+      digitalWrite(_dc2, HIGH);
+    }
+    spi->endTransaction();
+  }
+}
+
+// M1, M2, S1, S2: with dc1 and dc2 on different pins, each controller starts while the one before is uploading
+void GxEPD2_1248::_writeScreenBufferParts(uint8_t command, uint8_t value)
+{
+  ScreenPart* parts[] = {&M1, &M2, &S1, &S2};
+  for (uint8_t i = 0; i < 4; i++)
   {
-    SPI.transfer(pgm_read_byte(&*data++));
+    _awaitConflicts(*parts[i]);
+    parts[i]->writeScreenBuffer(command, value);
   }
-  while (fill_with_zeroes > 0)
+  _awaitParts();
+}
+
+// S2, M1, M2, S1: with dc1 and dc2 on different pins, each controller starts while the one before is uploading
+void GxEPD2_1248::_writeImageParts(uint8_t command, const uint8_t bitmap[], int16_t x_part, int16_t y_part, int16_t w_bitmap, int16_t h_bitmap,
+                                   int16_t x, int16_t y, int16_t w, int16_t h, bool invert, bool mirror_y, bool pgm)
+{
+  _awaitConflicts(S2);
+  S2.writeImagePart(command, bitmap, x_part, y_part, w_bitmap, h_bitmap, x, y, w, h, invert, mirror_y, pgm);
+  _awaitConflicts(M1);
+  M1.writeImagePart(command, bitmap, x_part, y_part, w_bitmap, h_bitmap, x, y - S2.HEIGHT, w, h, invert, mirror_y, pgm);
+  _awaitConflicts(M2);
+  M2.writeImagePart(command, bitmap, x_part, y_part, w_bitmap, h_bitmap, x - S2.WIDTH, y, w, h, invert, mirror_y, pgm);
+  _awaitConflicts(S1);
+  S1.writeImagePart(command, bitmap, x_part, y_part, w_bitmap, h_bitmap, x - M1.WIDTH, y - M2.HEIGHT, w, h, invert, mirror_y, pgm);
+  _awaitParts();
+}
+
+void GxEPD2_1248::_awaitConflicts(ScreenPart& part)
+{
+  ScreenPart* parts[] = {&M1, &S1, &M2, &S2};
+  for (uint8_t i = 0; i < 4; i++)
   {
-    SPI.transfer(0x00);
-    fill_with_zeroes--;
+    if ((parts[i] != &part) && parts[i]->conflicts(part)) parts[i]->awaitTransfer();
   }
-  digitalWrite(_cs_m1, HIGH);
-  digitalWrite(_cs_s1, HIGH);
-  digitalWrite(_cs_m2, HIGH);
-  digitalWrite(_cs_s2, HIGH);
-  SPI.endTransaction();
+}
+
+void GxEPD2_1248::_awaitParts()
+{
+  M1.awaitTransfer();
+  S1.awaitTransfer();
+  M2.awaitTransfer();
+  S2.awaitTransfer();
 }
 
 void GxEPD2_1248::_waitWhileAnyBusy(const char* comment, uint16_t busy_time)
 {
+#if defined(GxEPD2_HOST)
+  GxEPD2_HostBusyPhase(_busy_m1, _busy_level, busy_time); // host panel model, see extras/host
+  GxEPD2_HostBusyPhase(_busy_s1, _busy_level, busy_time);
+  GxEPD2_HostBusyPhase(_busy_m2, _busy_level, busy_time);
+  GxEPD2_HostBusyPhase(_busy_s2, _busy_level, busy_time);
+#endif
   if (_busy_m1 >= 0)
   {
     delay(1); // add some margin to become active
@@ -616,6 +654,7 @@ void GxEPD2_1248::_waitWhileAnyBusy(const char* comment, uint16_t busy_time)
         break;
       }
     }
+    _countBusy(comment, micros() - start);
     if (comment)
     {
       if (_diag_enabled)
@@ -628,7 +667,11 @@ void GxEPD2_1248::_waitWhileAnyBusy(const char* comment, uint16_t busy_time)
     }
     (void) start;
   }
-  else delay(busy_time);
+  else
+  {
+    delay(busy_time);
+    _countBusy(comment, 1000ul * busy_time);
+  }
 }
 
 void GxEPD2_1248::_getMasterTemperature()
@@ -636,7 +679,7 @@ void GxEPD2_1248::_getMasterTemperature()
   uint8_t value = 0;
   M1.writeCommand(0x40);
   _waitWhileAnyBusy("getMasterTemperature", 300);
-  SPI.end();
+  _pSPIx->end();
   pinMode(_mosi, INPUT);
   delay(100);
   digitalWrite(_sck, HIGH);
@@ -667,15 +710,15 @@ void GxEPD2_1248::_readController(uint8_t cmd, uint8_t* data, uint16_t n, int8_t
 {
   if (cs < 0) cs = _cs_m1;
   if (dc < 0) dc = _dc1;
-  SPI.beginTransaction(_spi_settings);
+  _pSPIx->beginTransaction(_spi_settings);
   digitalWrite(cs, LOW);
   digitalWrite(dc, LOW);
-  SPI.transfer(cmd);
+  _pSPIx->transfer(cmd);
   digitalWrite(dc, HIGH);
   digitalWrite(cs, HIGH);
-  SPI.endTransaction();
+  _pSPIx->endTransaction();
   _waitWhileAnyBusy("_readController", 300);
-  SPI.end();
+  _pSPIx->end();
   pinMode(_mosi, INPUT);
   delay(100);
   digitalWrite(_sck, HIGH);
@@ -704,23 +747,63 @@ void GxEPD2_1248::_readController(uint8_t cmd, uint8_t* data, uint16_t n, int8_t
 
 GxEPD2_1248::ScreenPart::ScreenPart(uint16_t width, uint16_t height, bool rev_scan, int16_t cs, int16_t dc) :
   WIDTH(width), HEIGHT(height), _rev_scan(rev_scan),
-  _cs(cs), _dc(dc), _spi_settings(4000000, MSBFIRST, SPI_MODE0)
+  _cs(cs), _dc(dc), _pSPIx(&SPI), _spi_settings(4000000, MSBFIRST, SPI_MODE0),
+  _pAsyncSPI(0), _async_buffer(0), _async_buffer_size(0), _async_fill(0), _async_index(0),
+  _async_transfer_active(false), _async_transfer_pending(false), _partial_out_pending(false)
 {
 }
 
-void GxEPD2_1248::ScreenPart::writeScreenBuffer(uint8_t command, uint8_t value)
+void GxEPD2_1248::ScreenPart::selectSPI(SPIClass& spi, SPISettings spi_settings)
 {
-  writeCommand(command); // set current or previous
-  for (uint32_t i = 0; i < uint32_t(WIDTH) * uint32_t(HEIGHT) / 8; i++)
+  awaitTransfer();
+  _pSPIx = &spi;
+  _spi_settings = spi_settings;
+}
+
+void GxEPD2_1248::ScreenPart::selectAsyncTransfer(GxEPD2_AsyncSPI* async_spi, uint8_t* staging_buffer, uint16_t staging_buffer_size)
+{
+  awaitTransfer();
+  bool usable = async_spi && staging_buffer && (staging_buffer_size >= 2);
+  _pAsyncSPI = usable ? async_spi : 0;
+  _async_buffer = usable ? staging_buffer : 0;
+  _async_buffer_size = usable ? staging_buffer_size : 0;
+  _async_fill = 0;
+  _async_index = 0;
+}
+
+void GxEPD2_1248::ScreenPart::awaitTransfer()
+{
+  if (!_async_transfer_pending) return;
+  _queueAsync(); // rest of an unfinished transfer
+  while (_pAsyncSPI->pending() > 0)
+  {
+#if defined(ESP8266) || defined(ESP32)
+    yield(); // avoid wdt
+#endif
+  }
+  _async_transfer_active = false;
+  _async_transfer_pending = false;
+  if (_cs >= 0) digitalWrite(_cs, HIGH);
+  _pSPIx->endTransaction();
+  if (_partial_out_pending)
   {
-    writeData(value);
+    _partial_out_pending = false;
+    writeCommand(0x92); // partial out
+    delay(1); // yield() to avoid WDT on ESP8266 and ESP32
   }
 }
 
+void GxEPD2_1248::ScreenPart::writeScreenBuffer(uint8_t command, uint8_t value)
+{
+  writeCommand(command); // set current or previous
+  _startTransfer();
+  _transferFill(value, uint32_t(WIDTH) * uint32_t(HEIGHT) / 8);
+  _endTransfer();
+}
+
 void GxEPD2_1248::ScreenPart::writeImagePart(uint8_t command, const uint8_t bitmap[], int16_t x_part, int16_t y_part, int16_t w_bitmap, int16_t h_bitmap,
     int16_t x, int16_t y, int16_t w, int16_t h, bool invert, bool mirror_y, bool pgm)
 {
-  delay(1); // yield() to avoid WDT on ESP8266 and ESP32
   if ((w_bitmap < 0) || (h_bitmap < 0) || (w < 0) || (h < 0)) return;
   if ((x_part < 0) || (x_part >= w_bitmap)) return;
   if ((y_part < 0) || (y_part >= h_bitmap)) return;
@@ -738,7 +821,8 @@ void GxEPD2_1248::ScreenPart::writeImagePart(uint8_t command, const uint8_t bitm
   int16_t dy = y1 - y;
   w1 -= dx;
   h1 -= dy;
-  if ((w1 <= 0) || (h1 <= 0)) return;
+  if ((w1 <= 0) || (h1 <= 0)) return; // not on this part, no bus time spent
+  delay(1); // yield() to avoid WDT on ESP8266 and ESP32
   //Serial.print(x); Serial.print(", "); Serial.print(y); Serial.print(", "); Serial.print(w); Serial.print(", "); Serial.println(h);
   //Serial.print("->"); Serial.print(x1); Serial.print(", "); Serial.print(y1); Serial.print(", "); Serial.print(w1); Serial.print(", "); Serial.println(h1);
   writeCommand(0x91); // partial in
@@ -748,50 +832,40 @@ void GxEPD2_1248::ScreenPart::writeImagePart(uint8_t command, const uint8_t bitm
   _startTransfer();
   for (int16_t i = 0; i < h1; i++)
   {
-    for (int16_t j = 0; j < w1 / 8; j++)
-    {
-      uint8_t data;
-      // use wb_bitmap, h_bitmap of bitmap for index!
-      int32_t idx = mirror_y ? x_part / 8 + j + dx / 8 + ((h_bitmap - 1 - (y_part + i + dy))) * wb_bitmap : x_part / 8 + j + dx / 8 + (y_part + i + dy) * wb_bitmap;
-      if (pgm)
-      {
-#if defined(__AVR) || defined(ESP8266) || defined(ESP32)
-        data = pgm_read_byte(&bitmap[idx]);
-#else
-        data = bitmap[idx];
-#endif
-      }
-      else
-      {
-        data = bitmap[idx];
-      }
-      if (invert) data = ~data;
-      _transfer(data);
-    }
+    // use wb_bitmap, h_bitmap of bitmap for index!
+    int32_t idx = mirror_y ? x_part / 8 + dx / 8 + ((h_bitmap - 1 - (y_part + i + dy))) * wb_bitmap : x_part / 8 + dx / 8 + (y_part + i + dy) * wb_bitmap;
+    _transferRow(&bitmap[idx], w1 / 8, invert, pgm);
   }
   _endTransfer();
+  if (_async_transfer_pending)
+  {
+    _partial_out_pending = true; // by awaitTransfer(), after the data is sent
+    return;
+  }
   writeCommand(0x92); // partial out
   delay(1); // yield() to avoid WDT on ESP8266 and ESP32
 }
 
 void GxEPD2_1248::ScreenPart::writeCommand(uint8_t c)
 {
-  SPI.beginTransaction(_spi_settings);
+  awaitTransfer();
+  _pSPIx->beginTransaction(_spi_settings);
   if (_dc >= 0) digitalWrite(_dc, LOW);
   if (_cs >= 0) digitalWrite(_cs, LOW);
-  SPI.transfer(c);
+  _pSPIx->transfer(c);
   if (_cs >= 0) digitalWrite(_cs, HIGH);
   if (_dc >= 0) digitalWrite(_dc, HIGH);
-  SPI.endTransaction();
+  _pSPIx->endTransaction();
 }
 
 void GxEPD2_1248::ScreenPart::writeData(uint8_t d)
 {
-  SPI.beginTransaction(_spi_settings);
+  awaitTransfer();
+  _pSPIx->beginTransaction(_spi_settings);
   if (_cs >= 0) digitalWrite(_cs, LOW);
-  SPI.transfer(d);
+  _pSPIx->transfer(d);
   if (_cs >= 0) digitalWrite(_cs, HIGH);
-  SPI.endTransaction();
+  _pSPIx->endTransaction();
 }
 
 void GxEPD2_1248::ScreenPart::_setPartialRamArea(uint16_t x, uint16_t y, uint16_t w, uint16_t h)
@@ -800,31 +874,118 @@ void GxEPD2_1248::ScreenPart::_setPartialRamArea(uint16_t x, uint16_t y, uint16_
   uint16_t xe = (x + w - 1) | 0x0007; // byte boundary inclusive (last byte)
   uint16_t ye = y + h - 1;
   x &= 0xFFF8; // byte boundary
-  writeCommand(0x90); // partial window
-  writeData(x / 256);
-  writeData(x % 256);
-  writeData(xe / 256);
-  writeData(xe % 256);
-  writeData(y / 256);
-  writeData(y % 256);
-  writeData(ye / 256);
-  writeData(ye % 256);
-  writeData(0x01);
+  const uint8_t partial_window[] =
+  {
+    0x90, // partial window
+    uint8_t(x / 256), uint8_t(x % 256), uint8_t(xe / 256), uint8_t(xe % 256),
+    uint8_t(y / 256), uint8_t(y % 256), uint8_t(ye / 256), uint8_t(ye % 256), 0x01
+  };
+  _writeCommandData(partial_window, sizeof(partial_window));
+}
+
+void GxEPD2_1248::ScreenPart::_writeCommandData(const uint8_t* pCommandData, uint8_t datalen)
+{
+  awaitTransfer();
+  _pSPIx->beginTransaction(_spi_settings);
+  if (_dc >= 0) digitalWrite(_dc, LOW);
+  if (_cs >= 0) digitalWrite(_cs, LOW);
+  _pSPIx->transfer(*pCommandData++);
+  if (_dc >= 0) digitalWrite(_dc, HIGH);
+  for (uint8_t i = 1; i < datalen; i++)  // sub the command
+  {
+    _pSPIx->transfer(*pCommandData++);
+  }
+  if (_cs >= 0) digitalWrite(_cs, HIGH);
+  _pSPIx->endTransaction();
 }
 
 void GxEPD2_1248::ScreenPart::_startTransfer()
 {
-  SPI.beginTransaction(_spi_settings);
+  awaitTransfer();
+  _pSPIx->beginTransaction(_spi_settings);
   if (_cs >= 0) digitalWrite(_cs, LOW);
+  if (_pAsyncSPI)
+  {
+    _async_transfer_active = true;
+    _async_transfer_pending = true;
+  }
 }
 
 void GxEPD2_1248::ScreenPart::_transfer(uint8_t value)
 {
-  SPI.transfer(value);
+  if (_async_transfer_active) _stageAsync(&value, 1, false, false, false);
+  else _pSPIx->transfer(value);
+}
+
+void GxEPD2_1248::ScreenPart::_transferRow(const uint8_t* data, uint32_t n, bool invert, bool pgm)
+{
+  if (_async_transfer_active) _stageAsync(data, n, invert, pgm, false);
+  else GxEPD2_EPD::_transferRow(*_pSPIx, data, n, invert, pgm);
+}
+
+void GxEPD2_1248::ScreenPart::_transferFill(uint8_t value, uint32_t n)
+{
+  if (_async_transfer_active) _stageAsync(&value, n, false, false, true);
+  else GxEPD2_EPD::_transferFill(*_pSPIx, value, n);
 }
 
 void GxEPD2_1248::ScreenPart::_endTransfer()
 {
+  if (_async_transfer_active)
+  {
+    // queue the rest, CS stays active until completion, see awaitTransfer()
+    _queueAsync();
+    _async_transfer_active = false;
+    return;
+  }
   if (_cs >= 0) digitalWrite(_cs, HIGH);
-  SPI.endTransaction();
+  _pSPIx->endTransaction();
+}
+
+void GxEPD2_1248::ScreenPart::_stageAsync(const uint8_t* data, uint32_t n, bool invert, bool pgm, bool fill)
+{
+  uint16_t half = _async_buffer_size / 2;
+  while (n > 0)
+  {
+    uint8_t* buffer = _async_buffer + _async_index * half;
+    if (0 == _async_fill)
+    {
+      // this half is free if at most the other half is still queued
+      while (_pAsyncSPI->pending() > 1)
+      {
+#if defined(ESP8266) || defined(ESP32)
+        yield(); // avoid wdt
+#endif
+      }
+    }
+    uint16_t chunk = n < uint32_t(half - _async_fill) ? n : half - _async_fill;
+    for (uint16_t i = 0; i < chunk; i++)
+    {
+      uint16_t j = fill ? 0 : i;
+#if defined(__AVR) || defined(ESP8266) || defined(ESP32)
+      uint8_t d = pgm ? pgm_read_byte(&data[j]) : data[j];
+#else
+      uint8_t d = data[j];
+#endif
+      buffer[_async_fill + i] = invert ? ~d : d;
+    }
+    if (!fill) data += chunk;
+    _async_fill += chunk;
+    n -= chunk;
+    if (_async_fill == half) _queueAsync();
+  }
+}
+
+void GxEPD2_1248::ScreenPart::_queueAsync()
+{
+  if (0 == _async_fill) return;
+  uint8_t* buffer = _async_buffer + _async_index * (_async_buffer_size / 2);
+  while (!_pAsyncSPI->queue(buffer, _async_fill))
+  {
+#if defined(ESP8266) || defined(ESP32)
+    yield(); // avoid wdt
+#endif
+  }
+  _async_index ^= 1;
+  _async_fill = 0;
 }
@@ -45,6 +45,17 @@ class GxEPD2_1248 : public GxEPD2_EPD
                 int16_t busy_m1, int16_t busy_s1, int16_t busy_m2, int16_t busy_s2);
     // constructor with minimal parameter set, standard SPI, dc1 and dc2, rst1 and rst2 to one pin, one busy used (can be -1)
     GxEPD2_1248(int16_t cs_m1, int16_t cs_s1, int16_t cs_m2, int16_t cs_s2, int16_t dc, int16_t rst, int16_t busy);
+    // SPI bus of all four controllers, or one bus per controller, e.g. two controllers on each SPI host of ESP32;
+    // spi_settings for all transfers. the bus of M1 is begun by init(), any other bus must be begun by the application.
+    // init() reads the temperature from M1 by bit banging on the sck and mosi pins of the constructor.
+    void selectSPI(SPIClass& spi, SPISettings spi_settings);
+    void selectSPI(SPIClass& spi_m1, SPIClass& spi_s1, SPIClass& spi_m2, SPIClass& spi_s2, SPISettings spi_settings);
+    // asynchronous image upload per controller, see GxEPD2_EPD::selectAsyncTransfer(); staging_buffer is split in four.
+    // controllers on different buses, and with different dc pins, upload in parallel; a controller waits only for
+    // the transfers it shares bus, dc pin or backend with. all transfers are completed when a write method returns.
+    void selectAsyncTransfer(GxEPD2_AsyncSPI* async_spi, uint8_t* staging_buffer, uint16_t staging_buffer_size);
+    void selectAsyncTransfer(GxEPD2_AsyncSPI* async_m1, GxEPD2_AsyncSPI* async_s1, GxEPD2_AsyncSPI* async_m2, GxEPD2_AsyncSPI* async_s2,
+                             uint8_t* staging_buffer, uint16_t staging_buffer_size);
     // methods (virtual)
     void init(uint32_t serial_diag_bitrate = 0); // serial_diag_bitrate = 0 : disabled
     void init(uint32_t serial_diag_bitrate, bool initial, uint16_t reset_duration = 20, bool pulldown_rst_mode = false);
@@ -94,6 +105,10 @@ class GxEPD2_1248 : public GxEPD2_EPD
     void _writeCommandAll(uint8_t c);
     void _writeDataAll(uint8_t d);
     void _writeDataPGM_All(const uint8_t* data, uint16_t n, int16_t fill_with_zeroes = 0);
+    void _writeParts(bool masters, bool command, const uint8_t* data, uint16_t n, bool pgm = false, int16_t fill_with_zeroes = 0);
+    void _writeScreenBufferParts(uint8_t command, uint8_t value);
+    void _writeImageParts(uint8_t command, const uint8_t bitmap[], int16_t x_part, int16_t y_part, int16_t w_bitmap, int16_t h_bitmap,
+                          int16_t x, int16_t y, int16_t w, int16_t h, bool invert, bool mirror_y, bool pgm);
     void _waitWhileAnyBusy(const char* comment = 0, uint16_t busy_time = 5000);
     void _getMasterTemperature();
   private:
@@ -115,6 +130,18 @@ class GxEPD2_1248 : public GxEPD2_EPD
     {
       public:
         ScreenPart(uint16_t width, uint16_t height, bool rev_scan, int16_t cs, int16_t dc);
+        void selectSPI(SPIClass& spi, SPISettings spi_settings);
+        void selectAsyncTransfer(GxEPD2_AsyncSPI* async_spi, uint8_t* staging_buffer, uint16_t staging_buffer_size);
+        void awaitTransfer(); // and the partial out of an asynchronous writeImagePart()
+        SPIClass* bus()
+        {
+          return _pSPIx;
+        };
+        // can't transfer while other does: same bus, dc pin or asynchronous backend
+        bool conflicts(const ScreenPart& other) const
+        {
+          return (_pSPIx == other._pSPIx) || (_dc == other._dc) || (_pAsyncSPI && (_pAsyncSPI == other._pAsyncSPI));
+        };
         void writeScreenBuffer(uint8_t command, uint8_t value = 0xFF); // init controller memory current (default white)
         void writeImagePart(uint8_t command, const uint8_t bitmap[], int16_t x_part, int16_t y_part, int16_t w_bitmap, int16_t h_bitmap,
                             int16_t x, int16_t y, int16_t w, int16_t h, bool invert = false, bool mirror_y = false, bool pgm = false);
@@ -122,17 +149,30 @@ class GxEPD2_1248 : public GxEPD2_EPD
         void writeData(uint8_t d);
       private:
         void _setPartialRamArea(uint16_t x, uint16_t y, uint16_t w, uint16_t h);
+        void _writeCommandData(const uint8_t* pCommandData, uint8_t datalen); // command and its data in one transaction
         void _startTransfer();
         void _transfer(uint8_t value);
+        void _transferRow(const uint8_t* data, uint32_t n, bool invert = false, bool pgm = false);
+        void _transferFill(uint8_t value, uint32_t n);
         void _endTransfer();
+        void _stageAsync(const uint8_t* data, uint32_t n, bool invert, bool pgm, bool fill);
+        void _queueAsync();
       public:
         const uint16_t WIDTH, HEIGHT;
       private:
         bool _rev_scan;
         int16_t _cs, _dc;
-        const SPISettings _spi_settings;
+        SPIClass* _pSPIx;
+        SPISettings _spi_settings;
+        GxEPD2_AsyncSPI* _pAsyncSPI;
+        uint8_t* _async_buffer;
+        uint16_t _async_buffer_size, _async_fill;
+        uint8_t _async_index;
+        bool _async_transfer_active, _async_transfer_pending, _partial_out_pending;
     };
     ScreenPart M1, S1, M2, S2;
+    void _awaitConflicts(ScreenPart& part); // before part transfers
+    void _awaitParts();
 };
 
 #endif
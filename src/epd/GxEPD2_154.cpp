@@ -26,10 +26,7 @@ void GxEPD2_154::clearScreen(uint8_t value)
     _setPartialRamArea(0, 0, WIDTH, HEIGHT);
     _writeCommand(0x24);
     _startTransfer();
-    for (uint32_t i = 0; i < uint32_t(WIDTH) * uint32_t(HEIGHT) / 8; i++)
-    {
-      _transfer(value);
-    }
+    _transferFill(value, uint32_t(WIDTH) * uint32_t(HEIGHT) / 8);
     _endTransfer();
     _Update_Full();
     _initial_refresh = false; // initial full update done
@@ -40,10 +37,7 @@ void GxEPD2_154::clearScreen(uint8_t value)
     _setPartialRamArea(0, 0, WIDTH, HEIGHT);
     _writeCommand(0x24);
     _startTransfer();
-    for (uint32_t i = 0; i < uint32_t(WIDTH) * uint32_t(HEIGHT) / 8; i++)
-    {
-      _transfer(value);
-    }
+    _transferFill(value, uint32_t(WIDTH) * uint32_t(HEIGHT) / 8);
     _endTransfer();
     _Update_Part();
   }
@@ -51,10 +45,7 @@ void GxEPD2_154::clearScreen(uint8_t value)
   _setPartialRamArea(0, 0, WIDTH, HEIGHT);
   _writeCommand(0x24);
   _startTransfer();
-  for (uint32_t i = 0; i < uint32_t(WIDTH) * uint32_t(HEIGHT) / 8; i++)
-  {
-    _transfer(value);
-  }
+  _transferFill(value, uint32_t(WIDTH) * uint32_t(HEIGHT) / 8);
   _endTransfer();
   _Update_Part();
 }
@@ -73,10 +64,7 @@ void GxEPD2_154::_writeScreenBuffer(uint8_t value)
   _setPartialRamArea(0, 0, WIDTH, HEIGHT);
   _writeCommand(0x24);
   _startTransfer();
-  for (uint32_t i = 0; i < uint32_t(WIDTH) * uint32_t(HEIGHT) / 8; i++)
-  {
-    _transfer(value);
-  }
+  _transferFill(value, uint32_t(WIDTH) * uint32_t(HEIGHT) / 8);
   _endTransfer();
 }
 
@@ -102,26 +90,9 @@ void GxEPD2_154::writeImage(const uint8_t bitmap[], int16_t x, int16_t y, int16_
   _startTransfer();
   for (int16_t i = 0; i < h1; i++)
   {
-    for (int16_t j = 0; j < w1 / 8; j++)
-    {
-      uint8_t data;
-      // use wb, h of bitmap for index!
-      int16_t idx = mirror_y ? j + dx / 8 + ((h - 1 - (i + dy))) * wb : j + dx / 8 + (i + dy) * wb;
-      if (pgm)
-      {
-#if defined(__AVR) || defined(ESP8266) || defined(ESP32)
-        data = pgm_read_byte(&bitmap[idx]);
-#else
-        data = bitmap[idx];
-#endif
-      }
-      else
-      {
-        data = bitmap[idx];
-      }
-      if (invert) data = ~data;
-      _transfer(data);
-    }
+    // use wb, h of bitmap for index!
+    uint32_t idx = mirror_y ? dx / 8 + uint32_t((h - 1 - (i + dy))) * wb : dx / 8 + uint32_t(i + dy) * wb;
+    _transferRow(&bitmap[idx], w1 / 8, invert, pgm);
   }
   _endTransfer();
   delay(1); // yield() to avoid WDT on ESP8266 and ESP32
@@ -156,26 +127,9 @@ void GxEPD2_154::writeImagePart(const uint8_t bitmap[], int16_t x_part, int16_t
   _startTransfer();
   for (int16_t i = 0; i < h1; i++)
   {
-    for (int16_t j = 0; j < w1 / 8; j++)
-    {
-      uint8_t data;
-      // use wb_bitmap, h_bitmap of bitmap for index!
-      int16_t idx = mirror_y ? x_part / 8 + j + dx / 8 + ((h_bitmap - 1 - (y_part + i + dy))) * wb_bitmap : x_part / 8 + j + dx / 8 + (y_part + i + dy) * wb_bitmap;
-      if (pgm)
-      {
-#if defined(__AVR) || defined(ESP8266) || defined(ESP32)
-        data = pgm_read_byte(&bitmap[idx]);
-#else
-        data = bitmap[idx];
-#endif
-      }
-      else
-      {
-        data = bitmap[idx];
-      }
-      if (invert) data = ~data;
-      _transfer(data);
-    }
+    // use wb_bitmap, h_bitmap of bitmap for index!
+    uint32_t idx = mirror_y ? x_part / 8 + dx / 8 + uint32_t((h_bitmap - 1 - (y_part + i + dy))) * wb_bitmap : x_part / 8 + dx / 8 + uint32_t(y_part + i + dy) * wb_bitmap;
+    _transferRow(&bitmap[idx], w1 / 8, invert, pgm);
   }
   _endTransfer();
   delay(1); // yield() to avoid WDT on ESP8266 and ESP32
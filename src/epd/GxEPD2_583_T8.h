@@ -28,6 +28,7 @@ class GxEPD2_583_T8 : public GxEPD2_EPD
     static const bool hasPartialUpdate = true;
     static const bool usePartialUpdateWindow = false; // set false for better image
     static const bool hasFastPartialUpdate = true; // set this false to force full refresh always
+    static const bool hasPreviousImageSync = true; // N2OCP: copy new to old on refresh
     static const uint16_t power_on_time = 140; // ms, e.g. 134460us
     static const uint16_t power_off_time = 42; // ms, e.g. 40033us
     static const uint16_t full_refresh_time = 4200; // ms, e.g. 4108238us
@@ -30,10 +30,7 @@ void GxEPD2_750::writeScreenBuffer(uint8_t value)
   if (value == 0xFF) value = 0x33; // white value for this controller
   _writeCommand(0x10);
   _startTransfer();
-  for (uint32_t i = 0; i < uint32_t(WIDTH) * uint32_t(HEIGHT) / 2; i++)
-  {
-    _transfer(value);
-  }
+  _transferFill(value, uint32_t(WIDTH) * uint32_t(HEIGHT) / 2);
   _endTransfer();
 }
 
@@ -64,7 +61,7 @@ void GxEPD2_750::writeImage(const uint8_t bitmap[], int16_t x, int16_t y, int16_
     {
       uint8_t data;
       // use wb, h of bitmap for index!
-      uint16_t idx = mirror_y ? j + dx / 8 + uint16_t((h - 1 - (i + dy))) * wb : j + dx / 8 + uint16_t(i + dy) * wb;
+      uint32_t idx = mirror_y ? j + dx / 8 + uint32_t((h - 1 - (i + dy))) * wb : j + dx / 8 + uint32_t(i + dy) * wb;
       if (pgm)
       {
 #if defined(__AVR) || defined(ESP8266) || defined(ESP32)
@@ -120,7 +117,7 @@ void GxEPD2_750::writeImagePart(const uint8_t bitmap[], int16_t x_part, int16_t
     {
       uint8_t data;
       // use wb_bitmap, h_bitmap of bitmap for index!
-      uint16_t idx = mirror_y ? x_part / 8 + j + dx / 8 + uint16_t((h_bitmap - 1 - (y_part + i + dy))) * wb_bitmap : x_part / 8 + j + dx / 8 + uint16_t(y_part + i + dy) * wb_bitmap;
+      uint32_t idx = mirror_y ? x_part / 8 + j + dx / 8 + uint32_t((h_bitmap - 1 - (y_part + i + dy))) * wb_bitmap : x_part / 8 + j + dx / 8 + uint32_t(y_part + i + dy) * wb_bitmap;
       if (pgm)
       {
 #if defined(__AVR) || defined(ESP8266) || defined(ESP32)
@@ -184,26 +181,9 @@ void GxEPD2_750::writeNative(const uint8_t* data1, const uint8_t* data2, int16_t
     _startTransfer();
     for (int16_t i = 0; i < h1; i++)
     {
-      for (int16_t j = 0; j < w1 / 2; j++)
-      {
-        uint8_t data;
-        // use wb, h of bitmap for index!
-        uint16_t idx = mirror_y ? j + dx / 2 + uint16_t((h - 1 - (i + dy))) * wb : j + dx / 2 + uint16_t(i + dy) * wb;
-        if (pgm)
-        {
-#if defined(__AVR) || defined(ESP8266) || defined(ESP32)
-          data = pgm_read_byte(&data1[idx]);
-#else
-          data = data1[idx];
-#endif
-        }
-        else
-        {
-          data = data1[idx];
-        }
-        if (invert) data = ~data;
-        _transfer(data);
-      }
+      // use wb, h of bitmap for index!
+      uint32_t idx = mirror_y ? dx / 2 + uint32_t((h - 1 - (i + dy))) * wb : dx / 2 + uint32_t(i + dy) * wb;
+      _transferRow(&data1[idx], w1 / 2, invert, pgm);
     }
     _endTransfer();
     _writeCommand(0x92); // partial out
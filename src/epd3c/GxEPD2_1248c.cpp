@@ -65,6 +65,35 @@ GxEPD2_1248c::GxEPD2_1248c(int16_t cs_m1, int16_t cs_s1, int16_t cs_m2, int16_t
 {
 }
 
+void GxEPD2_1248c::selectSPI(SPIClass& spi, SPISettings spi_settings)
+{
+  selectSPI(spi, spi, spi, spi, spi_settings);
+}
+
+void GxEPD2_1248c::selectSPI(SPIClass& spi_m1, SPIClass& spi_s1, SPIClass& spi_m2, SPIClass& spi_s2, SPISettings spi_settings)
+{
+  GxEPD2_EPD::selectSPI(spi_m1, spi_settings);
+  M1.selectSPI(spi_m1, spi_settings);
+  S1.selectSPI(spi_s1, spi_settings);
+  M2.selectSPI(spi_m2, spi_settings);
+  S2.selectSPI(spi_s2, spi_settings);
+}
+
+void GxEPD2_1248c::selectAsyncTransfer(GxEPD2_AsyncSPI* async_spi, uint8_t* staging_buffer, uint16_t staging_buffer_size)
+{
+  selectAsyncTransfer(async_spi, async_spi, async_spi, async_spi, staging_buffer, staging_buffer_size);
+}
+
+void GxEPD2_1248c::selectAsyncTransfer(GxEPD2_AsyncSPI* async_m1, GxEPD2_AsyncSPI* async_s1, GxEPD2_AsyncSPI* async_m2, GxEPD2_AsyncSPI* async_s2,
+                                      uint8_t* staging_buffer, uint16_t staging_buffer_size)
+{
+  uint16_t quarter = staging_buffer ? staging_buffer_size / 4 : 0;
+  M1.selectAsyncTransfer(async_m1, staging_buffer, quarter);
+  S1.selectAsyncTransfer(async_s1, staging_buffer + quarter, quarter);
+  M2.selectAsyncTransfer(async_m2, staging_buffer + 2 * quarter, quarter);
+  S2.selectAsyncTransfer(async_s2, staging_buffer + 3 * quarter, quarter);
+}
+
 void GxEPD2_1248c::init(uint32_t serial_diag_bitrate)
 {
   init(serial_diag_bitrate, true, 20, false);
@@ -109,12 +138,16 @@ void GxEPD2_1248c::clearScreen(uint8_t value)
   refresh(true);
 }
 
+// M1, M2, S1, S2: with dc1 and dc2 on different pins, each controller starts while the one before is uploading
 void GxEPD2_1248c::_writeScreenBuffer(uint8_t command, uint8_t value)
 {
-  M1.writeScreenBuffer(command, value);
-  S1.writeScreenBuffer(command, value);
-  M2.writeScreenBuffer(command, value);
-  S2.writeScreenBuffer(command, value);
+  ScreenPart* parts[] = {&M1, &M2, &S1, &S2};
+  for (uint8_t i = 0; i < 4; i++)
+  {
+    _awaitConflicts(*parts[i]);
+    parts[i]->writeScreenBuffer(command, value);
+  }
+  _awaitParts();
 }
 
 void GxEPD2_1248c::writeScreenBuffer(uint8_t value)
@@ -133,34 +166,29 @@ void GxEPD2_1248c::writeScreenBuffer(uint8_t black_value, uint8_t color_value)
   _initial_write = false; // initial full screen buffer clean done
 }
 
-void GxEPD2_1248c::_writeImage(uint8_t command, const uint8_t* bitmap, int16_t x, int16_t y, int16_t w, int16_t h, bool invert, bool mirror_y, bool pgm)
-{
-  if (bitmap)
-  {
-    S2.writeImagePart(command, bitmap, 0, 0, w, h, x, y, w, h, invert, mirror_y, pgm);
-    M2.writeImagePart(command, bitmap, 0, 0, w, h, x - S2.WIDTH, y, w, h, invert, mirror_y, pgm);
-    M1.writeImagePart(command, bitmap, 0, 0, w, h, x, y - S2.HEIGHT, w, h, invert, mirror_y, pgm);
-    S1.writeImagePart(command, bitmap, 0, 0, w, h, x - M1.WIDTH, y - M2.HEIGHT, w, h, invert, mirror_y, pgm);
-  }
-}
-
 void GxEPD2_1248c::writeImage(const uint8_t bitmap[], int16_t x, int16_t y, int16_t w, int16_t h, bool invert, bool mirror_y, bool pgm)
 {
   if (_initial_write) writeScreenBuffer(); // initial full screen buffer clean
   if (!_using_partial_mode) _Init_Part();
-  _writeImage(0x10, bitmap, x, y, w, h, invert, mirror_y, pgm); // black
+  _writeImagePart(bitmap, 0, 0, 0, w, h, x, y, w, h, invert, mirror_y, pgm); // black
   _writeScreenBuffer(0x13, 0x0); // color (white)
 }
 
-void GxEPD2_1248c::_writeImagePart(uint8_t command, const uint8_t* bitmap, int16_t x_part, int16_t y_part, int16_t w_bitmap, int16_t h_bitmap,
+// S2, M1, M2, S1: with dc1 and dc2 on different pins, each controller starts while the one before is uploading
+void GxEPD2_1248c::_writeImagePart(const uint8_t* black, const uint8_t* color, int16_t x_part, int16_t y_part, int16_t w_bitmap, int16_t h_bitmap,
                                    int16_t x, int16_t y, int16_t w, int16_t h, bool invert, bool mirror_y, bool pgm)
 {
-  if (bitmap)
+  if (black || color)
   {
-    S2.writeImagePart(command, bitmap, x_part, y_part, w, h, x, y, w, h, invert, mirror_y, pgm);
-    M2.writeImagePart(command, bitmap, x_part, y_part, w, h, x - S2.WIDTH, y, w, h, invert, mirror_y, pgm);
-    M1.writeImagePart(command, bitmap, x_part, y_part, w, h, x, y - S2.HEIGHT, w, h, invert, mirror_y, pgm);
-    S1.writeImagePart(command, bitmap, x_part, y_part, w, h, x - M1.WIDTH, y - M2.HEIGHT, w, h, invert, mirror_y, pgm);
+    _awaitConflicts(S2);
+    S2.writeImagePart(black, color, x_part, y_part, w_bitmap, h_bitmap, x, y, w, h, invert, mirror_y, pgm);
+    _awaitConflicts(M1);
+    M1.writeImagePart(black, color, x_part, y_part, w_bitmap, h_bitmap, x, y - S2.HEIGHT, w, h, invert, mirror_y, pgm);
+    _awaitConflicts(M2);
+    M2.writeImagePart(black, color, x_part, y_part, w_bitmap, h_bitmap, x - S2.WIDTH, y, w, h, invert, mirror_y, pgm);
+    _awaitConflicts(S1);
+    S1.writeImagePart(black, color, x_part, y_part, w_bitmap, h_bitmap, x - M1.WIDTH, y - M2.HEIGHT, w, h, invert, mirror_y, pgm);
+    _awaitParts();
   }
 }
 
@@ -169,15 +197,14 @@ void GxEPD2_1248c::writeImagePart(const uint8_t bitmap[], int16_t x_part, int16_
 {
   if (_initial_write) writeScreenBuffer(); // initial full screen buffer clean
   if (!_using_partial_mode) _Init_Part();
-  _writeImagePart(0x10, bitmap, x_part, y_part, w, h, x, y, w, h, invert, mirror_y, pgm); // black
+  _writeImagePart(bitmap, 0, x_part, y_part, w_bitmap, h_bitmap, x, y, w, h, invert, mirror_y, pgm); // black
 }
 
 void GxEPD2_1248c::writeImage(const uint8_t* black, const uint8_t* color, int16_t x, int16_t y, int16_t w, int16_t h, bool invert, bool mirror_y, bool pgm)
 {
   if (_initial_write) writeScreenBuffer(); // initial full screen buffer clean
   if (!_using_partial_mode) _Init_Part();
-  _writeImage(0x10, black, x, y, w, h, invert, mirror_y, pgm);
-  _writeImage(0x13, color, x, y, w, h, !invert, mirror_y, pgm);
+  _writeImagePart(black, color, 0, 0, w, h, x, y, w, h, invert, mirror_y, pgm);
 }
 
 void GxEPD2_1248c::writeImagePart(const uint8_t* black, const uint8_t* color, int16_t x_part, int16_t y_part, int16_t w_bitmap, int16_t h_bitmap,
@@ -185,8 +212,7 @@ void GxEPD2_1248c::writeImagePart(const uint8_t* black, const uint8_t* color, in
 {
   if (_initial_write) writeScreenBuffer(); // initial full screen buffer clean
   if (!_using_partial_mode) _Init_Part();
-  _writeImagePart(0x10, black, x_part, y_part, w, h, x, y, w, h, invert, mirror_y, pgm);
-  _writeImagePart(0x13, color, x_part, y_part, w, h, x, y, w, h, !invert, mirror_y, pgm);
+  _writeImagePart(black, color, x_part, y_part, w_bitmap, h_bitmap, x, y, w, h, invert, mirror_y, pgm);
 }
 
 void GxEPD2_1248c::writeNative(const uint8_t* data1, const uint8_t* data2, int16_t x, int16_t y, int16_t w, int16_t h, bool invert, bool mirror_y, bool pgm)
@@ -276,12 +302,12 @@ void GxEPD2_1248c::_initSPI()
 #if defined(ESP32)
   if ((SCK != _sck) || (MISO != _miso) || (MOSI != _mosi))
   {
-    SPI.end();
-    SPI.begin(_sck, _miso, _mosi, _cs_m1);
+    _pSPIx->end();
+    _pSPIx->begin(_sck, _miso, _mosi, _cs_m1);
   }
-  else SPI.begin();
+  else _pSPIx->begin();
 #else
-  SPI.begin();
+  _pSPIx->begin();
 #endif
 }
 
@@ -417,89 +443,95 @@ void GxEPD2_1248c::_Update_Part()
 
 void GxEPD2_1248c::_writeCommandMaster(uint8_t c)
 {
-  SPI.beginTransaction(_spi_settings);
-  digitalWrite(_dc1, LOW);
-  digitalWrite(_dc2, LOW);
-  digitalWrite(_cs_m1, LOW);
-  digitalWrite(_cs_m2, LOW);
-  SPI.transfer(c);
-  digitalWrite(_cs_m1, HIGH);
-  digitalWrite(_cs_m2, HIGH);
-  digitalWrite(_dc1, HIGH);
-  digitalWrite(_dc2, HIGH);
-  SPI.endTransaction();
+  _writeParts(true, true, &c, 1);
 }
 
 void GxEPD2_1248c::_writeDataMaster(uint8_t d)
 {
-  SPI.beginTransaction(_spi_settings);
-  digitalWrite(_cs_m1, LOW);
-  digitalWrite(_cs_m2, LOW);
-  SPI.transfer(d);
-  digitalWrite(_cs_m1, HIGH);
-  digitalWrite(_cs_m2, HIGH);
-  SPI.endTransaction();
+  _writeParts(true, false, &d, 1);
 }
 
 void GxEPD2_1248c::_writeCommandAll(uint8_t c)
 {
-  SPI.beginTransaction(_spi_settings);
-  digitalWrite(_dc1, LOW);
-  digitalWrite(_dc2, LOW);
-  digitalWrite(_cs_m1, LOW);
-  digitalWrite(_cs_s1, LOW);
-  digitalWrite(_cs_m2, LOW);
-  digitalWrite(_cs_s2, LOW);
-  SPI.transfer(c);
-  digitalWrite(_cs_m1, HIGH);
-  digitalWrite(_cs_s1, HIGH);
-  digitalWrite(_cs_m2, HIGH);
-  digitalWrite(_cs_s2, HIGH);
-  digitalWrite(_dc1, HIGH);
-  digitalWrite(_dc2, HIGH);
-  SPI.endTransaction();
+  _writeParts(false, true, &c, 1);
 }
 
 void GxEPD2_1248c::_writeDataAll(uint8_t d)
 {
-  SPI.beginTransaction(_spi_settings);
-  digitalWrite(_cs_m1, LOW);
-  digitalWrite(_cs_s1, LOW);
-  digitalWrite(_cs_m2, LOW);
-  digitalWrite(_cs_s2, LOW);
-  SPI.transfer(d);
-  digitalWrite(_cs_m1, HIGH);
-  digitalWrite(_cs_s1, HIGH);
-  digitalWrite(_cs_m2, HIGH);
-  digitalWrite(_cs_s2, HIGH);
-  SPI.endTransaction();
+  _writeParts(false, false, &d, 1);
 }
 
 void GxEPD2_1248c::_writeDataPGM_All(const uint8_t* data, uint16_t n, int16_t fill_with_zeroes)
 {
-  SPI.beginTransaction(_spi_settings);
-  digitalWrite(_cs_m1, LOW);
-  digitalWrite(_cs_s1, LOW);
-  digitalWrite(_cs_m2, LOW);
-  digitalWrite(_cs_s2, LOW);
-  for (uint16_t i = 0; i < n; i++)
+  _writeParts(false, false, data, n, true, fill_with_zeroes);
+}
+
+// to the masters or all controllers at once, one transaction per SPI bus
+void GxEPD2_1248c::_writeParts(bool masters, bool command, const uint8_t* data, uint16_t n, bool pgm, int16_t fill_with_zeroes)
+{
+  ScreenPart* parts[] = {&M1, &S1, &M2, &S2};
+  int16_t cs[] = {_cs_m1, _cs_s1, _cs_m2, _cs_s2};
+  uint8_t selected = masters ? 0x05 : 0x0F; // bit i for parts[i]
+  for (uint8_t i = 0; i < 4; i++)
   {
-    SPI.transfer(pgm_read_byte(&*data++));
+    if (!(selected & (1 << i))) continue; // not selected or done with a bus before
+    SPIClass* spi = parts[i]->bus();
+    spi->beginTransaction(_spi_settings);
+    if (command)
+    {
+      digitalWrite(_dc1, LOW);
+      digitalWrite(_dc2, LOW);
+    }
+    uint8_t on_bus = 0;
+    for (uint8_t j = i; j < 4; j++)
+    {
+      if ((selected & (1 << j)) && (parts[j]->bus() == spi)) on_bus |= 1 << j;
+    }
+    selected &= ~on_bus;
+    for (uint8_t j = i; j < 4; j++) if (on_bus & (1 << j)) digitalWrite(cs[j], LOW);
+    for (uint16_t k = 0; k < n; k++)
+    {
+      spi->transfer(pgm ? pgm_read_byte(&data[k]) : data[k]);
+    }
+    for (int16_t k = fill_with_zeroes; k > 0; k--)
+    {
+      spi->transfer(0x00);
+    }
+    for (uint8_t j = i; j < 4; j++) if (on_bus & (1 << j)) digitalWrite(cs[j], HIGH);
+    if (command)
+    {
+      digitalWrite(_dc1, HIGH);
+      digitalWrite(_dc2, HIGH);
+    }
+    spi->endTransaction();
   }
-  while (fill_with_zeroes > 0)
+}
+
+void GxEPD2_1248c::_awaitConflicts(ScreenPart& part)
+{
+  ScreenPart* parts[] = {&M1, &S1, &M2, &S2};
+  for (uint8_t i = 0; i < 4; i++)
   {
-    SPI.transfer(0x00);
-    fill_with_zeroes--;
+    if ((parts[i] != &part) && parts[i]->conflicts(part)) parts[i]->awaitTransfer();
   }
-  digitalWrite(_cs_m1, HIGH);
-  digitalWrite(_cs_s1, HIGH);
-  digitalWrite(_cs_m2, HIGH);
-  digitalWrite(_cs_s2, HIGH);
-  SPI.endTransaction();
+}
+
+void GxEPD2_1248c::_awaitParts()
+{
+  M1.awaitTransfer();
+  S1.awaitTransfer();
+  M2.awaitTransfer();
+  S2.awaitTransfer();
 }
 
 void GxEPD2_1248c::_waitWhileAnyBusy(const char* comment, uint16_t busy_time)
 {
+#if defined(GxEPD2_HOST)
+  GxEPD2_HostBusyPhase(_busy_m1, _busy_level, busy_time); // host panel model, see extras/host
+  GxEPD2_HostBusyPhase(_busy_s1, _busy_level, busy_time);
+  GxEPD2_HostBusyPhase(_busy_m2, _busy_level, busy_time);
+  GxEPD2_HostBusyPhase(_busy_s2, _busy_level, busy_time);
+#endif
   if (_busy_m1 >= 0)
   {
     delay(1); // add some margin to become active
@@ -519,6 +551,7 @@ void GxEPD2_1248c::_waitWhileAnyBusy(const char* comment, uint16_t busy_time)
         break;
       }
     }
+    _countBusy(comment, micros() - start);
     if (comment)
     {
       if (_diag_enabled)
@@ -531,7 +564,11 @@ void GxEPD2_1248c::_waitWhileAnyBusy(const char* comment, uint16_t busy_time)
     }
     (void) start;
   }
-  else delay(busy_time);
+  else
+  {
+    delay(busy_time);
+    _countBusy(comment, 1000ul * busy_time);
+  }
 }
 
 void GxEPD2_1248c::_getMasterTemperature()
@@ -539,7 +576,7 @@ void GxEPD2_1248c::_getMasterTemperature()
   uint8_t value = 0;
   M1.writeCommand(0x40);
   _waitWhileAnyBusy("getMasterTemperature", 300);
-  SPI.end();
+  _pSPIx->end();
   pinMode(_mosi, INPUT);
   delay(100);
   digitalWrite(_sck, HIGH);
@@ -570,15 +607,15 @@ void GxEPD2_1248c::_readController(uint8_t cmd, uint8_t* data, uint16_t n, int8_
 {
   if (cs < 0) cs = _cs_m1;
   if (dc < 0) dc = _dc1;
-  SPI.beginTransaction(_spi_settings);
+  _pSPIx->beginTransaction(_spi_settings);
   digitalWrite(cs, LOW);
   digitalWrite(dc, LOW);
-  SPI.transfer(cmd);
+  _pSPIx->transfer(cmd);
   digitalWrite(dc, HIGH);
   digitalWrite(cs, HIGH);
-  SPI.endTransaction();
+  _pSPIx->endTransaction();
   _waitWhileAnyBusy("_readController", 300);
-  SPI.end();
+  _pSPIx->end();
   pinMode(_mosi, INPUT);
   delay(100);
   digitalWrite(_sck, HIGH);
@@ -607,23 +644,63 @@ void GxEPD2_1248c::_readController(uint8_t cmd, uint8_t* data, uint16_t n, int8_
 
 GxEPD2_1248c::ScreenPart::ScreenPart(uint16_t width, uint16_t height, bool rev_scan, int16_t cs, int16_t dc) :
   WIDTH(width), HEIGHT(height), _rev_scan(rev_scan),
-  _cs(cs), _dc(dc), _spi_settings(4000000, MSBFIRST, SPI_MODE0)
+  _cs(cs), _dc(dc), _pSPIx(&SPI), _spi_settings(4000000, MSBFIRST, SPI_MODE0),
+  _pAsyncSPI(0), _async_buffer(0), _async_buffer_size(0), _async_fill(0), _async_index(0),
+  _async_transfer_active(false), _async_transfer_pending(false), _partial_out_pending(false)
 {
 }
 
-void GxEPD2_1248c::ScreenPart::writeScreenBuffer(uint8_t command, uint8_t value)
+void GxEPD2_1248c::ScreenPart::selectSPI(SPIClass& spi, SPISettings spi_settings)
 {
-  writeCommand(command); // set current or previous
-  for (uint32_t i = 0; i < uint32_t(WIDTH) * uint32_t(HEIGHT) / 8; i++)
+  awaitTransfer();
+  _pSPIx = &spi;
+  _spi_settings = spi_settings;
+}
+
+void GxEPD2_1248c::ScreenPart::selectAsyncTransfer(GxEPD2_AsyncSPI* async_spi, uint8_t* staging_buffer, uint16_t staging_buffer_size)
+{
+  awaitTransfer();
+  bool usable = async_spi && staging_buffer && (staging_buffer_size >= 2);
+  _pAsyncSPI = usable ? async_spi : 0;
+  _async_buffer = usable ? staging_buffer : 0;
+  _async_buffer_size = usable ? staging_buffer_size : 0;
+  _async_fill = 0;
+  _async_index = 0;
+}
+
+void GxEPD2_1248c::ScreenPart::awaitTransfer()
+{
+  if (!_async_transfer_pending) return;
+  _queueAsync(); // rest of an unfinished transfer
+  while (_pAsyncSPI->pending() > 0)
   {
-    writeData(value);
+#if defined(ESP8266) || defined(ESP32)
+    yield(); // avoid wdt
+#endif
   }
+  _async_transfer_active = false;
+  _async_transfer_pending = false;
+  if (_cs >= 0) digitalWrite(_cs, HIGH);
+  _pSPIx->endTransaction();
+  if (_partial_out_pending)
+  {
+    _partial_out_pending = false;
+    writeCommand(0x92); // partial out
+    delay(1); // yield() to avoid WDT on ESP8266 and ESP32
+  }
+}
+
+void GxEPD2_1248c::ScreenPart::writeScreenBuffer(uint8_t command, uint8_t value)
+{
+  writeCommand(command); // set current or previous
+  _startTransfer();
+  _transferFill(value, uint32_t(WIDTH) * uint32_t(HEIGHT) / 8);
+  _endTransfer();
 }
 
-void GxEPD2_1248c::ScreenPart::writeImagePart(uint8_t command, const uint8_t bitmap[], int16_t x_part, int16_t y_part, int16_t w_bitmap, int16_t h_bitmap,
+void GxEPD2_1248c::ScreenPart::writeImagePart(const uint8_t* black, const uint8_t* color, int16_t x_part, int16_t y_part, int16_t w_bitmap, int16_t h_bitmap,
     int16_t x, int16_t y, int16_t w, int16_t h, bool invert, bool mirror_y, bool pgm)
 {
-  delay(1); // yield() to avoid WDT on ESP8266 and ESP32
   if ((w_bitmap < 0) || (h_bitmap < 0) || (w < 0) || (h < 0)) return;
   if ((x_part < 0) || (x_part >= w_bitmap)) return;
   if ((y_part < 0) || (y_part >= h_bitmap)) return;
@@ -641,60 +718,57 @@ void GxEPD2_1248c::ScreenPart::writeImagePart(uint8_t command, const uint8_t bit
   int16_t dy = y1 - y;
   w1 -= dx;
   h1 -= dy;
-  if ((w1 <= 0) || (h1 <= 0)) return;
+  if ((w1 <= 0) || (h1 <= 0)) return; // not on this part, no bus time spent
+  delay(1); // yield() to avoid WDT on ESP8266 and ESP32
   //Serial.print(x); Serial.print(", "); Serial.print(y); Serial.print(", "); Serial.print(w); Serial.print(", "); Serial.println(h);
   //Serial.print("->"); Serial.print(x1); Serial.print(", "); Serial.print(y1); Serial.print(", "); Serial.print(w1); Serial.print(", "); Serial.println(h1);
   writeCommand(0x91); // partial in
   delay(1);
   _setPartialRamArea(x1, y1, w1, h1);
-  writeCommand(command);
-  _startTransfer();
-  for (int16_t i = 0; i < h1; i++)
+  // both planes in the same partial window, color is inverted
+  for (uint8_t plane = 0; plane < 2; plane++)
   {
-    for (int16_t j = 0; j < w1 / 8; j++)
+    const uint8_t* bitmap = plane ? color : black;
+    if (!bitmap) continue;
+    writeCommand(plane ? 0x13 : 0x10);
+    _startTransfer();
+    for (int16_t i = 0; i < h1; i++)
     {
-      uint8_t data;
       // use wb_bitmap, h_bitmap of bitmap for index!
-      int32_t idx = mirror_y ? x_part / 8 + j + dx / 8 + ((h_bitmap - 1 - (y_part + i + dy))) * wb_bitmap : x_part / 8 + j + dx / 8 + (y_part + i + dy) * wb_bitmap;
-      if (pgm)
-      {
-#if defined(__AVR) || defined(ESP8266) || defined(ESP32)
-        data = pgm_read_byte(&bitmap[idx]);
-#else
-        data = bitmap[idx];
-#endif
-      }
-      else
-      {
-        data = bitmap[idx];
-      }
-      if (invert) data = ~data;
-      _transfer(data);
+      int32_t idx = mirror_y ? x_part / 8 + dx / 8 + ((h_bitmap - 1 - (y_part + i + dy))) * wb_bitmap : x_part / 8 + dx / 8 + (y_part + i + dy) * wb_bitmap;
+      _transferRow(&bitmap[idx], w1 / 8, plane ? !invert : invert, pgm);
     }
+    _endTransfer();
+  }
+  if (_async_transfer_pending)
+  {
+    _partial_out_pending = true; // by awaitTransfer(), after the data is sent
+    return;
   }
-  _endTransfer();
   writeCommand(0x92); // partial out
   delay(1); // yield() to avoid WDT on ESP8266 and ESP32
 }
 
 void GxEPD2_1248c::ScreenPart::writeCommand(uint8_t c)
 {
-  SPI.beginTransaction(_spi_settings);
+  awaitTransfer();
+  _pSPIx->beginTransaction(_spi_settings);
   if (_dc >= 0) digitalWrite(_dc, LOW);
   if (_cs >= 0) digitalWrite(_cs, LOW);
-  SPI.transfer(c);
+  _pSPIx->transfer(c);
   if (_cs >= 0) digitalWrite(_cs, HIGH);
   if (_dc >= 0) digitalWrite(_dc, HIGH);
-  SPI.endTransaction();
+  _pSPIx->endTransaction();
 }
 
 void GxEPD2_1248c::ScreenPart::writeData(uint8_t d)
 {
-  SPI.beginTransaction(_spi_settings);
+  awaitTransfer();
+  _pSPIx->beginTransaction(_spi_settings);
   if (_cs >= 0) digitalWrite(_cs, LOW);
-  SPI.transfer(d);
+  _pSPIx->transfer(d);
   if (_cs >= 0) digitalWrite(_cs, HIGH);
-  SPI.endTransaction();
+  _pSPIx->endTransaction();
 }
 
 void GxEPD2_1248c::ScreenPart::_setPartialRamArea(uint16_t x, uint16_t y, uint16_t w, uint16_t h)
@@ -703,31 +777,118 @@ void GxEPD2_1248c::ScreenPart::_setPartialRamArea(uint16_t x, uint16_t y, uint16
   uint16_t xe = (x + w - 1) | 0x0007; // byte boundary inclusive (last byte)
   uint16_t ye = y + h - 1;
   x &= 0xFFF8; // byte boundary
-  writeCommand(0x90); // partial window
-  writeData(x / 256);
-  writeData(x % 256);
-  writeData(xe / 256);
-  writeData(xe % 256);
-  writeData(y / 256);
-  writeData(y % 256);
-  writeData(ye / 256);
-  writeData(ye % 256);
-  writeData(0x01);
+  const uint8_t partial_window[] =
+  {
+    0x90, // partial window
+    uint8_t(x / 256), uint8_t(x % 256), uint8_t(xe / 256), uint8_t(xe % 256),
+    uint8_t(y / 256), uint8_t(y % 256), uint8_t(ye / 256), uint8_t(ye % 256), 0x01
+  };
+  _writeCommandData(partial_window, sizeof(partial_window));
+}
+
+void GxEPD2_1248c::ScreenPart::_writeCommandData(const uint8_t* pCommandData, uint8_t datalen)
+{
+  awaitTransfer();
+  _pSPIx->beginTransaction(_spi_settings);
+  if (_dc >= 0) digitalWrite(_dc, LOW);
+  if (_cs >= 0) digitalWrite(_cs, LOW);
+  _pSPIx->transfer(*pCommandData++);
+  if (_dc >= 0) digitalWrite(_dc, HIGH);
+  for (uint8_t i = 1; i < datalen; i++)  // sub the command
+  {
+    _pSPIx->transfer(*pCommandData++);
+  }
+  if (_cs >= 0) digitalWrite(_cs, HIGH);
+  _pSPIx->endTransaction();
 }
 
 void GxEPD2_1248c::ScreenPart::_startTransfer()
 {
-  SPI.beginTransaction(_spi_settings);
+  awaitTransfer();
+  _pSPIx->beginTransaction(_spi_settings);
   if (_cs >= 0) digitalWrite(_cs, LOW);
+  if (_pAsyncSPI)
+  {
+    _async_transfer_active = true;
+    _async_transfer_pending = true;
+  }
 }
 
 void GxEPD2_1248c::ScreenPart::_transfer(uint8_t value)
 {
-  SPI.transfer(value);
+  if (_async_transfer_active) _stageAsync(&value, 1, false, false, false);
+  else _pSPIx->transfer(value);
+}
+
+void GxEPD2_1248c::ScreenPart::_transferRow(const uint8_t* data, uint32_t n, bool invert, bool pgm)
+{
+  if (_async_transfer_active) _stageAsync(data, n, invert, pgm, false);
+  else GxEPD2_EPD::_transferRow(*_pSPIx, data, n, invert, pgm);
+}
+
+void GxEPD2_1248c::ScreenPart::_transferFill(uint8_t value, uint32_t n)
+{
+  if (_async_transfer_active) _stageAsync(&value, n, false, false, true);
+  else GxEPD2_EPD::_transferFill(*_pSPIx, value, n);
 }
 
 void GxEPD2_1248c::ScreenPart::_endTransfer()
 {
+  if (_async_transfer_active)
+  {
+    // queue the rest, CS stays active until completion, see awaitTransfer()
+    _queueAsync();
+    _async_transfer_active = false;
+    return;
+  }
   if (_cs >= 0) digitalWrite(_cs, HIGH);
-  SPI.endTransaction();
+  _pSPIx->endTransaction();
+}
+
+void GxEPD2_1248c::ScreenPart::_stageAsync(const uint8_t* data, uint32_t n, bool invert, bool pgm, bool fill)
+{
+  uint16_t half = _async_buffer_size / 2;
+  while (n > 0)
+  {
+    uint8_t* buffer = _async_buffer + _async_index * half;
+    if (0 == _async_fill)
+    {
+      // this half is free if at most the other half is still queued
+      while (_pAsyncSPI->pending() > 1)
+      {
+#if defined(ESP8266) || defined(ESP32)
+        yield(); // avoid wdt
+#endif
+      }
+    }
+    uint16_t chunk = n < uint32_t(half - _async_fill) ? n : half - _async_fill;
+    for (uint16_t i = 0; i < chunk; i++)
+    {
+      uint16_t j = fill ? 0 : i;
+#if defined(__AVR) || defined(ESP8266) || defined(ESP32)
+      uint8_t d = pgm ? pgm_read_byte(&data[j]) : data[j];
+#else
+      uint8_t d = data[j];
+#endif
+      buffer[_async_fill + i] = invert ? ~d : d;
+    }
+    if (!fill) data += chunk;
+    _async_fill += chunk;
+    n -= chunk;
+    if (_async_fill == half) _queueAsync();
+  }
+}
+
+void GxEPD2_1248c::ScreenPart::_queueAsync()
+{
+  if (0 == _async_fill) return;
+  uint8_t* buffer = _async_buffer + _async_index * (_async_buffer_size / 2);
+  while (!_pAsyncSPI->queue(buffer, _async_fill))
+  {
+#if defined(ESP8266) || defined(ESP32)
+    yield(); // avoid wdt
+#endif
+  }
+  _async_index ^= 1;
+  _async_fill = 0;
 }
@@ -30,17 +30,11 @@ void GxEPD2_420c::clearScreen(uint8_t black_value, uint8_t color_value)
   _setPartialRamArea(0, 0, WIDTH, HEIGHT);
   _writeCommand(0x10);
   _startTransfer();
-  for (uint32_t i = 0; i < uint32_t(WIDTH) * uint32_t(HEIGHT) / 8; i++)
-  {
-    _transfer(black_value);
-  }
+  _transferFill(black_value, uint32_t(WIDTH) * uint32_t(HEIGHT) / 8);
   _endTransfer();
   _writeCommand(0x13);
   _startTransfer();
-  for (uint32_t i = 0; i < uint32_t(WIDTH) * uint32_t(HEIGHT) / 8; i++)
-  {
-    _transfer(color_value);
-  }
+  _transferFill(color_value, uint32_t(WIDTH) * uint32_t(HEIGHT) / 8);
   _endTransfer();
   _Update_Part();
   _writeCommand(0x92); // partial out
@@ -59,17 +53,11 @@ void GxEPD2_420c::writeScreenBuffer(uint8_t black_value, uint8_t color_value)
   _setPartialRamArea(0, 0, WIDTH, HEIGHT);
   _writeCommand(0x10);
   _startTransfer();
-  for (uint16_t i = 0; i < uint32_t(WIDTH) * uint32_t(HEIGHT) / 8; i++)
-  {
-    _transfer(black_value);
-  }
+  _transferFill(black_value, uint32_t(WIDTH) * uint32_t(HEIGHT) / 8);
   _endTransfer();
   _writeCommand(0x13);
   _startTransfer();
-  for (uint16_t i = 0; i < uint32_t(WIDTH) * uint32_t(HEIGHT) / 8; i++)
-  {
-    _transfer(color_value);
-  }
+  _transferFill(color_value, uint32_t(WIDTH) * uint32_t(HEIGHT) / 8);
   _endTransfer();
   _writeCommand(0x92); // partial out
 }
@@ -102,58 +90,26 @@ void GxEPD2_420c::writeImage(const uint8_t* black, const uint8_t* color, int16_t
   _startTransfer();
   for (int16_t i = 0; i < h1; i++)
   {
-    for (int16_t j = 0; j < w1 / 8; j++)
+    if (black)
     {
-      uint8_t data = 0xFF;
-      if (black)
-      {
-        // use wb, h of bitmap for index!
-        int16_t idx = mirror_y ? j + dx / 8 + ((h - 1 - (i + dy))) * wb : j + dx / 8 + (i + dy) * wb;
-        if (pgm)
-        {
-#if defined(__AVR) || defined(ESP8266) || defined(ESP32)
-          data = pgm_read_byte(&black[idx]);
-#else
-          data = black[idx];
-#endif
-        }
-        else
-        {
-          data = black[idx];
-        }
-        if (invert) data = ~data;
-      }
-      _transfer(data);
+      // use wb, h of bitmap for index!
+      uint32_t idx = mirror_y ? dx / 8 + uint32_t((h - 1 - (i + dy))) * wb : dx / 8 + uint32_t(i + dy) * wb;
+      _transferRow(&black[idx], w1 / 8, invert, pgm);
     }
+    else _transferFill(0xFF, w1 / 8);
   }
   _endTransfer();
   _writeCommand(0x13);
   _startTransfer();
   for (int16_t i = 0; i < h1; i++)
   {
-    for (int16_t j = 0; j < w1 / 8; j++)
+    if (color)
     {
-      uint8_t data = 0xFF;
-      if (color)
-      {
-        // use wb, h of bitmap for index!
-        int16_t idx = mirror_y ? j + dx / 8 + ((h - 1 - (i + dy))) * wb : j + dx / 8 + (i + dy) * wb;
-        if (pgm)
-        {
-#if defined(__AVR) || defined(ESP8266) || defined(ESP32)
-          data = pgm_read_byte(&color[idx]);
-#else
-          data = color[idx];
-#endif
-        }
-        else
-        {
-          data = color[idx];
-        }
-        if (invert) data = ~data;
-      }
-      _transfer(data);
+      // use wb, h of bitmap for index!
+      uint32_t idx = mirror_y ? dx / 8 + uint32_t((h - 1 - (i + dy))) * wb : dx / 8 + uint32_t(i + dy) * wb;
+      _transferRow(&color[idx], w1 / 8, invert, pgm);
     }
+    else _transferFill(0xFF, w1 / 8);
   }
   _endTransfer();
   _writeCommand(0x92); // partial out
@@ -196,55 +152,22 @@ void GxEPD2_420c::writeImagePart(const uint8_t* black, const uint8_t* color, int
   _startTransfer();
   for (int16_t i = 0; i < h1; i++)
   {
-    for (int16_t j = 0; j < w1 / 8; j++)
-    {
-      uint8_t data;
-      // use wb_bitmap, h_bitmap of bitmap for index!
-      int16_t idx = mirror_y ? x_part / 8 + j + dx / 8 + ((h_bitmap - 1 - (y_part + i + dy))) * wb_bitmap : x_part / 8 + j + dx / 8 + (y_part + i + dy) * wb_bitmap;
-      if (pgm)
-      {
-#if defined(__AVR) || defined(ESP8266) || defined(ESP32)
-        data = pgm_read_byte(&black[idx]);
-#else
-        data = black[idx];
-#endif
-      }
-      else
-      {
-        data = black[idx];
-      }
-      if (invert) data = ~data;
-      _transfer(data);
-    }
+    // use wb_bitmap, h_bitmap of bitmap for index!
+    uint32_t idx = mirror_y ? x_part / 8 + dx / 8 + uint32_t((h_bitmap - 1 - (y_part + i + dy))) * wb_bitmap : x_part / 8 + dx / 8 + uint32_t(y_part + i + dy) * wb_bitmap;
+    _transferRow(&black[idx], w1 / 8, invert, pgm);
   }
   _endTransfer();
   _writeCommand(0x13);
   _startTransfer();
   for (int16_t i = 0; i < h1; i++)
   {
-    for (int16_t j = 0; j < w1 / 8; j++)
+    if (color)
     {
-      uint8_t data = 0xFF;
-      if (color)
-      {
-        // use wb_bitmap, h_bitmap of bitmap for index!
-        int16_t idx = mirror_y ? x_part / 8 + j + dx / 8 + ((h_bitmap - 1 - (y_part + i + dy))) * wb_bitmap : x_part / 8 + j + dx / 8 + (y_part + i + dy) * wb_bitmap;
-        if (pgm)
-        {
-#if defined(__AVR) || defined(ESP8266) || defined(ESP32)
-          data = pgm_read_byte(&color[idx]);
-#else
-          data = color[idx];
-#endif
-        }
-        else
-        {
-          data = color[idx];
-        }
-        if (invert) data = ~data;
-      }
-      _transfer(data);
+      // use wb_bitmap, h_bitmap of bitmap for index!
+      uint32_t idx = mirror_y ? x_part / 8 + dx / 8 + uint32_t((h_bitmap - 1 - (y_part + i + dy))) * wb_bitmap : x_part / 8 + dx / 8 + uint32_t(y_part + i + dy) * wb_bitmap;
+      _transferRow(&color[idx], w1 / 8, invert, pgm);
     }
+    else _transferFill(0xFF, w1 / 8);
   }
   _endTransfer();
   _writeCommand(0x92); // partial out
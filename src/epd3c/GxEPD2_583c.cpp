@@ -26,10 +26,7 @@ void GxEPD2_583c::clearScreen(uint8_t value)
   _setPartialRamArea(0, 0, WIDTH, HEIGHT);
   _writeCommand(0x10);
   _startTransfer();
-  for (uint32_t i = 0; i < uint32_t(WIDTH) * uint32_t(HEIGHT) / 2; i++)
-  {
-    _transfer(value);
-  }
+  _transferFill(value, uint32_t(WIDTH) * uint32_t(HEIGHT) / 2);
   _endTransfer();
   _Update_Part();
   _writeCommand(0x92); // partial out
@@ -61,10 +58,7 @@ void GxEPD2_583c::writeScreenBuffer(uint8_t value)
   _setPartialRamArea(0, 0, WIDTH, HEIGHT);
   _writeCommand(0x10);
   _startTransfer();
-  for (uint32_t i = 0; i < uint32_t(WIDTH) * uint32_t(HEIGHT) / 2; i++)
-  {
-    _transfer(value);
-  }
+  _transferFill(value, uint32_t(WIDTH) * uint32_t(HEIGHT) / 2);
   _endTransfer();
   _writeCommand(0x92); // partial out
 }
@@ -120,7 +114,7 @@ void GxEPD2_583c::writeImage(const uint8_t* black, const uint8_t* color, int16_t
       if (black)
       {
         // use wb, h of bitmap for index!
-        uint16_t idx = mirror_y ? j + dx / 8 + uint16_t((h - 1 - (i + dy))) * wb : j + dx / 8 + uint16_t(i + dy) * wb;
+        uint32_t idx = mirror_y ? j + dx / 8 + uint32_t((h - 1 - (i + dy))) * wb : j + dx / 8 + uint32_t(i + dy) * wb;
         if (pgm)
         {
 #if defined(__AVR) || defined(ESP8266) || defined(ESP32)
@@ -138,7 +132,7 @@ void GxEPD2_583c::writeImage(const uint8_t* black, const uint8_t* color, int16_t
       if (color)
       {
         // use wb, h of bitmap for index!
-        uint16_t idx = mirror_y ? j + dx / 8 + uint16_t((h - 1 - (i + dy))) * wb : j + dx / 8 + uint16_t(i + dy) * wb;
+        uint32_t idx = mirror_y ? j + dx / 8 + uint32_t((h - 1 - (i + dy))) * wb : j + dx / 8 + uint32_t(i + dy) * wb;
         if (pgm)
         {
 #if defined(__AVR) || defined(ESP8266) || defined(ESP32)
@@ -205,7 +199,7 @@ void GxEPD2_583c::writeImagePart(const uint8_t* black, const uint8_t* color, int
       uint8_t black_data = 0xFF;
       uint8_t color_data = 0xFF;
       // use wb_bitmap, h_bitmap of bitmap for index!
-      uint16_t idx = mirror_y ? x_part / 8 + j + dx / 8 + uint16_t((h_bitmap - 1 - (y_part + i + dy))) * wb_bitmap : x_part / 8 + j + dx / 8 + uint16_t(y_part + i + dy) * wb_bitmap;
+      uint32_t idx = mirror_y ? x_part / 8 + j + dx / 8 + uint32_t((h_bitmap - 1 - (y_part + i + dy))) * wb_bitmap : x_part / 8 + j + dx / 8 + uint32_t(y_part + i + dy) * wb_bitmap;
       if (black)
       {
         if (pgm)
@@ -274,26 +268,9 @@ void GxEPD2_583c::writeNative(const uint8_t* data1, const uint8_t* data2, int16_
     _startTransfer();
     for (int16_t i = 0; i < h1; i++)
     {
-      for (int16_t j = 0; j < w1 / 2; j++)
-      {
-        uint8_t data;
-        // use wb, h of bitmap for index!
-        uint16_t idx = mirror_y ? j + dx / 2 + uint16_t((h - 1 - (i + dy))) * wb : j + dx / 2 + uint16_t(i + dy) * wb;
-        if (pgm)
-        {
-#if defined(__AVR) || defined(ESP8266) || defined(ESP32)
-          data = pgm_read_byte(&data1[idx]);
-#else
-          data = data1[idx];
-#endif
-        }
-        else
-        {
-          data = data1[idx];
-        }
-        if (invert) data = ~data;
-        _transfer(data);
-      }
+      // use wb, h of bitmap for index!
+      uint32_t idx = mirror_y ? dx / 2 + uint32_t((h - 1 - (i + dy))) * wb : dx / 2 + uint32_t(i + dy) * wb;
+      _transferRow(&data1[idx], w1 / 2, invert, pgm);
     }
     _endTransfer();
     _writeCommand(0x92); // partial out
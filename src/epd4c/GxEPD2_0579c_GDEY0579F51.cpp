@@ -47,18 +47,12 @@ void GxEPD2_0579c_GDEY0579F51::writeScreenBuffer(uint8_t black_value, uint8_t co
   _setPartialRamAreaMaster(0, 0, WIDTH / 2, HEIGHT, false);
   _writeCommand(0x10);
   _startTransfer();
-  for (uint32_t i = 0; i < uint32_t(WIDTH / 2) * uint32_t(HEIGHT) / 4; i++)
-  {
-    _transfer(0xFF == black_value ? 0x55 : 0x00);
-  }
+  _transferFill(0xFF == black_value ? 0x55 : 0x00, uint32_t(WIDTH / 2) * uint32_t(HEIGHT) / 4);
   _endTransfer();
   _setPartialRamAreaSlave(0, 0, WIDTH / 2, HEIGHT, false);
   _writeCommand(0x10);
   _startTransfer();
-  for (uint32_t i = 0; i < uint32_t(WIDTH / 2) * uint32_t(HEIGHT) / 4; i++)
-  {
-    _transfer(0xFF == black_value ? 0x55 : 0x00);
-  }
+  _transferFill(0xFF == black_value ? 0x55 : 0x00, uint32_t(WIDTH / 2) * uint32_t(HEIGHT) / 4);
   _endTransfer();
   _initial_write = false; // initial full screen buffer clean done
 }
@@ -395,26 +389,9 @@ void GxEPD2_0579c_GDEY0579F51::writeImagePart(const uint8_t* black, const uint8_
 void GxEPD2_0579c_GDEY0579F51::_writeLineFromNative(const uint8_t* native, int16_t x, int16_t y, int16_t w, int16_t wbb, bool invert, bool pgm, bool trf)
 {
   if (trf) _startTransfer();
-  for (int16_t j = 0; j < w; j += 4)
-  {
-    uint8_t data;
-    // use wbb, h of bitmap for index!
-    uint32_t idx = uint32_t(x + j) / 4 + uint32_t(y) * wbb;
-    if (pgm)
-    {
-#if defined(__AVR) || defined(ESP8266) || defined(ESP32)
-      data = pgm_read_byte(&native[idx]);
-#else
-      data = native[idx];
-#endif
-    }
-    else
-    {
-      data = native[idx];
-    }
-    if (invert) data = ~data;
-    _transfer(data);
-  }
+  // use wbb, h of bitmap for index!
+  uint32_t idx = uint32_t(x) / 4 + uint32_t(y) * wbb;
+  _transferRow(&native[idx], (w + 3) / 4, invert, pgm);
   if (trf) _endTransfer();
 }
 
@@ -42,10 +42,7 @@ void GxEPD2_1160c_GDEY116F51::writeScreenBuffer(uint8_t black_value, uint8_t col
   _setPartialRamArea(0, 0, WIDTH, HEIGHT, false);
   _writeCommand(0x10);
   _startTransfer();
-  for (uint32_t i = 0; i < uint32_t(WIDTH) * uint32_t(HEIGHT) / 4; i++)
-  {
-    _transfer(0xFF == black_value ? 0x55 : 0x00);
-  }
+  _transferFill(0xFF == black_value ? 0x55 : 0x00, uint32_t(WIDTH) * uint32_t(HEIGHT) / 4);
   _endTransfer();
   _initial_write = false; // initial full screen buffer clean done
 }
@@ -629,11 +626,7 @@ void GxEPD2_1160c_GDEY116F51::writeNative(const uint8_t* data1, const uint8_t* d
     {
       //Serial.println("paged");
       _startTransfer();
-      for (uint32_t i = 0; i < uint32_t(WIDTH) * uint32_t(h) / 4; i++)
-      {
-        uint8_t data = data1[i];
-        _transfer(data);
-      }
+      _transferRow(data1, uint32_t(WIDTH) * uint32_t(h) / 4);
       _endTransfer();
       if (y + h == HEIGHT) // last page
       {
@@ -42,10 +42,7 @@ void GxEPD2_420c_GDEY0420F51::writeScreenBuffer(uint8_t black_value, uint8_t col
   if (!_init_display_done) _InitDisplay();
   _writeCommand(0x10);
   _startTransfer();
-  for (uint32_t i = 0; i < uint32_t(WIDTH) * uint32_t(HEIGHT) / 4; i++)
-  {
-    _transfer(0xFF == black_value ? 0x55 : 0x00);
-  }
+  _transferFill(0xFF == black_value ? 0x55 : 0x00, uint32_t(WIDTH) * uint32_t(HEIGHT) / 4);
   _endTransfer();
   _initial_write = false; // initial full screen buffer clean done
 }
@@ -599,26 +596,9 @@ void GxEPD2_420c_GDEY0420F51::writeNative(const uint8_t* data1, const uint8_t* d
     _startTransfer();
     for (int16_t i = 0; i < h1; i++)
     {
-      for (int16_t j = 0; j < w1 / 4; j++)
-      {
-        uint8_t data;
-        // use wb, h of bitmap for index!
-        uint32_t idx = mirror_y ? j + dx / 4 + uint32_t((h - 1 - (i + dy))) * wb : j + dx / 4 + uint32_t(i + dy) * wb;
-        if (pgm)
-        {
-#if defined(__AVR) || defined(ESP8266) || defined(ESP32)
-          data = pgm_read_byte(&data1[idx]);
-#else
-          data = data1[idx];
-#endif
-        }
-        else
-        {
-          data = data1[idx];
-        }
-        if (invert) data = ~data;
-        _transfer(data);
-      }
+      // use wb, h of bitmap for index!
+      uint32_t idx = mirror_y ? dx / 4 + uint32_t((h - 1 - (i + dy))) * wb : dx / 4 + uint32_t(i + dy) * wb;
+      _transferRow(&data1[idx], w1 / 4, invert, pgm);
     }
     _endTransfer();
   }
@@ -628,11 +608,7 @@ void GxEPD2_420c_GDEY0420F51::writeNative(const uint8_t* data1, const uint8_t* d
     {
       //Serial.println("paged");
       _startTransfer();
-      for (uint32_t i = 0; i < uint32_t(WIDTH) * uint32_t(h) / 4; i++)
-      {
-        uint8_t data = data1[i];
-        _transfer(data);
-      }
+      _transferRow(data1, uint32_t(WIDTH) * uint32_t(h) / 4);
       _endTransfer();
       if (y + h == HEIGHT) // last page
       {
@@ -717,26 +693,9 @@ void GxEPD2_420c_GDEY0420F51::writeNativePart(const uint8_t* data1, const uint8_
     _startTransfer();
     for (int16_t i = 0; i < h1; i++)
     {
-      for (int16_t j = 0; j < w1 / 4; j++)
-      {
-        uint8_t data;
-        // use wb_bitmap, h_bitmap of bitmap for index!
-        uint32_t idx = mirror_y ? x_part / 4 + j + dx / 4 + uint32_t((h_bitmap - 1 - (y_part + i + dy))) * wb_bitmap : x_part / 4 + j + dx / 4 + uint32_t(y_part + i + dy) * wb_bitmap;
-        if (pgm)
-        {
-#if defined(__AVR) || defined(ESP8266) || defined(ESP32)
-          data = pgm_read_byte(&data1[idx]);
-#else
-          data = data1[idx];
-#endif
-        }
-        else
-        {
-          data = data1[idx];
-        }
-        if (invert) data = ~data;
-        _transfer(data);
-      }
+      // use wb_bitmap, h_bitmap of bitmap for index!
+      uint32_t idx = mirror_y ? x_part / 4 + dx / 4 + uint32_t((h_bitmap - 1 - (y_part + i + dy))) * wb_bitmap : x_part / 4 + dx / 4 + uint32_t(y_part + i + dy) * wb_bitmap;
+      _transferRow(&data1[idx], w1 / 4, invert, pgm);
     }
     _endTransfer();
   }
@@ -41,11 +41,7 @@ void GxEPD2_565c::writeScreenBuffer(uint8_t black_value, uint8_t color_value)
   if (!_init_display_done) _InitDisplay();
   _writeCommand(0x10);
   _startTransfer();
-  for (uint32_t i = 0; i < uint32_t(WIDTH) * uint32_t(HEIGHT) / 2; i++)
-  {
-    //_transfer(0x11);
-    _transfer(0xFF == black_value ? 0x11 : black_value);
-  }
+  _transferFill(0xFF == black_value ? 0x11 : black_value, uint32_t(WIDTH) * uint32_t(HEIGHT) / 2);
   _endTransfer();
 }
 
@@ -367,11 +363,7 @@ void GxEPD2_565c::writeNative(const uint8_t* data1, const uint8_t* data2, int16_
     {
       //Serial.println("paged");
       _startTransfer();
-      for (uint32_t i = 0; i < uint32_t(WIDTH) * uint32_t(h) / 2; i++)
-      {
-        uint8_t data = data1[i];
-        _transfer(data);
-      }
+      _transferRow(data1, uint32_t(WIDTH) * uint32_t(h) / 2);
       _endTransfer();
       if (y + h == HEIGHT) // last page
       {
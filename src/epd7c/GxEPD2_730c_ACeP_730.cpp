@@ -40,11 +40,7 @@ void GxEPD2_730c_ACeP_730::writeScreenBuffer(uint8_t black_value, uint8_t color_
   if (!_init_display_done) _InitDisplay();
   _writeCommand(0x10);
   _startTransfer();
-  for (uint32_t i = 0; i < uint32_t(WIDTH) * uint32_t(HEIGHT) / 2; i++)
-  {
-    //_transfer(0x11);
-    _transfer(0xFF == black_value ? 0x11 : black_value);
-  }
+  _transferFill(0xFF == black_value ? 0x11 : black_value, uint32_t(WIDTH) * uint32_t(HEIGHT) / 2);
   _endTransfer();
 }
 
@@ -366,11 +362,7 @@ void GxEPD2_730c_ACeP_730::writeNative(const uint8_t* data1, const uint8_t* data
     {
       //Serial.println("paged");
       _startTransfer();
-      for (uint32_t i = 0; i < uint32_t(WIDTH) * uint32_t(h) / 2; i++)
-      {
-        uint8_t data = data1[i];
-        _transfer(data);
-      }
+      _transferRow(data1, uint32_t(WIDTH) * uint32_t(h) / 2);
       _endTransfer();
       if (y + h == HEIGHT) // last page
       {
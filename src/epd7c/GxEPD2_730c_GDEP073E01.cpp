@@ -40,11 +40,7 @@ void GxEPD2_730c_GDEP073E01::writeScreenBuffer(uint8_t black_value, uint8_t colo
   if (!_init_display_done) _InitDisplay();
   _writeCommand(0x10);
   _startTransfer();
-  for (uint32_t i = 0; i < uint32_t(WIDTH) * uint32_t(HEIGHT) / 2; i++)
-  {
-    //_transfer(0x11);
-    _transfer(0xFF == black_value ? 0x11 : black_value);
-  }
+  _transferFill(0xFF == black_value ? 0x11 : black_value, uint32_t(WIDTH) * uint32_t(HEIGHT) / 2);
   _endTransfer();
 }
 
@@ -28,6 +28,7 @@ class GxEPD2_583_GDEQ0583T31 : public GxEPD2_EPD
     static const bool hasPartialUpdate = true;
     static const bool usePartialUpdateWindow = false; // set false for better image
     static const bool hasFastPartialUpdate = true; // set this false to force full refresh always
+    static const bool hasPreviousImageSync = true; // N2OCP: copy new to old on refresh
     static const bool useFastFullUpdate = true; // set false for extended (low) temperature range
     static const uint16_t power_on_time = 130; // ms, e.g. 128998us
     static const uint16_t power_off_time = 40; // ms, e.g. 40000us
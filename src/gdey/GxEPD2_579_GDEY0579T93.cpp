@@ -47,34 +47,22 @@ void GxEPD2_579_GDEY0579T93::_writeScreenBuffer(uint8_t command, uint8_t value)
   _setPartialRamAreaMaster(0, 0, WIDTH / 2, HEIGHT);
   _writeCommand(command);
   _startTransfer();
-  for (uint32_t i = 0; i < uint32_t(WIDTH / 2) * uint32_t(HEIGHT) / 8; i++)
-  {
-    _transfer(value);
-  }
+  _transferFill(value, uint32_t(WIDTH / 2) * uint32_t(HEIGHT) / 8);
   _endTransfer();
   _setPartialRamAreaMaster(0, HEIGHT / 2, WIDTH / 2, HEIGHT);
   _writeCommand(command);
   _startTransfer();
-  for (uint32_t i = 0; i < uint32_t(WIDTH / 2) * uint32_t(HEIGHT) / 8; i++)
-  {
-    _transfer(value);
-  }
+  _transferFill(value, uint32_t(WIDTH / 2) * uint32_t(HEIGHT) / 8);
   _endTransfer();
   _setPartialRamAreaSlave(0, 0, WIDTH / 2, HEIGHT / 2);
   _writeCommand(command | 0x80);
   _startTransfer();
-  for (uint32_t i = 0; i < uint32_t(WIDTH / 2) * uint32_t(HEIGHT) / 8; i++)
-  {
-    _transfer(value);
-  }
+  _transferFill(value, uint32_t(WIDTH / 2) * uint32_t(HEIGHT) / 8);
   _endTransfer();
   _setPartialRamAreaSlave(0, HEIGHT / 2, WIDTH / 2, HEIGHT);
   _writeCommand(command | 0x80);
   _startTransfer();
-  for (uint32_t i = 0; i < uint32_t(WIDTH / 2) * uint32_t(HEIGHT) / 8; i++)
-  {
-    _transfer(value);
-  }
+  _transferFill(value, uint32_t(WIDTH / 2) * uint32_t(HEIGHT) / 8);
   _endTransfer();
 }
 
@@ -178,26 +166,9 @@ void GxEPD2_579_GDEY0579T93::_writeDataFromImage(const uint8_t bitmap[], int16_t
   _startTransfer();
   for (int16_t i = 0; i < h; i++)
   {
-    for (int16_t j = 0; j < w; j += 8)
-    {
-      uint8_t data;
-      // use wbb, h of bitmap for index!
-      int16_t idx = mirror_y ? ((j + dx) / 8 + ((hb - 1 - (i + dy))) * wbb) : ((j + dx) / 8 + (i + dy) * wbb);
-      if (pgm)
-      {
-#if defined(__AVR) || defined(ESP8266) || defined(ESP32)
-        data = pgm_read_byte(&bitmap[idx]);
-#else
-        data = bitmap[idx];
-#endif
-      }
-      else
-      {
-        data = bitmap[idx];
-      }
-      if (invert) data = ~data;
-      _transfer(data);
-    }
+    // use wbb, h of bitmap for index!
+    uint32_t idx = mirror_y ? (dx / 8 + uint32_t((hb - 1 - (i + dy))) * wbb) : (dx / 8 + uint32_t(i + dy) * wbb);
+    _transferRow(&bitmap[idx], (w + 7) / 8, invert, pgm);
   }
   _endTransfer();
 }
@@ -28,6 +28,7 @@ class GxEPD2_750_GDEY075T7 : public GxEPD2_EPD
     static const bool hasPartialUpdate = true;
     static const bool usePartialUpdateWindow = false; // set false for better image
     static const bool hasFastPartialUpdate = true; // set this false to force full refresh always
+    static const bool hasPreviousImageSync = true; // N2OCP: copy new to old on refresh
     static const bool useFastFullUpdate = true; // set false for extended (low) temperature range
     static const bool useFastPartialUpdateFromOTP = true; // set this false for earlier batches, such as the panel I have (1580258us)
     static const uint16_t power_on_time = 140; // ms, e.g. 129018us
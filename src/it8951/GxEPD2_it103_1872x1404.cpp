@@ -59,7 +59,8 @@
 GxEPD2_it103_1872x1404::GxEPD2_it103_1872x1404(int16_t cs, int16_t dc, int16_t rst, int16_t busy) :
   GxEPD2_EPD(cs, dc, rst, busy, LOW, 10000000, WIDTH, HEIGHT, panel, hasColor, hasPartialUpdate, hasFastPartialUpdate),
   _spi_settings(24000000, MSBFIRST, SPI_MODE0),
-  _spi_settings_for_read(1000000, MSBFIRST, SPI_MODE0)
+  _spi_settings_for_read(1000000, MSBFIRST, SPI_MODE0),
+  _refresh_mode(AUTO_MODE), _a2_mode(6), _grey_written(false)
 {
 }
 
@@ -96,6 +97,8 @@ void GxEPD2_it103_1872x1404::init(uint32_t serial_diag_bitrate, bool initial, ui
     Serial.print("FW Version = "); Serial.println((char*)IT8951DevInfo.usFWVersion);
     Serial.print("LUT Version = "); Serial.println((char*)IT8951DevInfo.usLUTVersion);
   }
+  // the A2 waveform mode depends on the LUT of the firmware, 4 for "M641" of 6" panels, 6 for the others
+  _a2_mode = (0 == strncmp((char*)IT8951DevInfo.usLUTVersion, "M641", 5)) ? 4 : 6;
   //Set to Enable I80 Packed mode
   _IT8951WriteReg(I80CPCR, 0x0001);
   if (VCOM != _IT8951GetVCOM())
@@ -115,23 +118,23 @@ void GxEPD2_it103_1872x1404::clearScreen(uint8_t value)
   if (_initial_refresh) _Init_Full();
   else _Init_Part();
   _initial_refresh = false;
-  _setPartialRamArea(0, 0, WIDTH, HEIGHT);
+  _setPartialRamArea(0, 0, WIDTH, HEIGHT, IT8951_4BPP);
   SPI.beginTransaction(_spi_settings);
   if (_cs >= 0) digitalWrite(_cs, LOW);
   _transfer16(0x0000); // preamble for write data
   _waitWhileBusy2("clearScreen preamble", default_wait_time);
-  for (uint32_t i = 0; i < uint32_t(WIDTH) * uint32_t(HEIGHT); i++)
+  for (uint16_t i = 0; i < HEIGHT; i++)
   {
-    SPI.transfer(value);
+    _transferFill(SPI, (value & 0xF0) | (value >> 4), WIDTH / 2); // 4bpp, 16 grey levels are used of 8bpp
 #if defined(ESP8266) || defined(ESP32)
-    if (0 == i % 10000) yield();
+    if (0 == i % 8) yield();
 #endif
   }
   if (_cs >= 0) digitalWrite(_cs, HIGH);
   SPI.endTransaction();
   _writeCommand16(IT8951_TCON_LD_IMG_END);
   _waitWhileBusy2("clearScreen load end", default_wait_time);
-  _refresh(0, 0, WIDTH, HEIGHT, false);
+  _refresh(0, 0, WIDTH, HEIGHT, GC16_MODE);
 }
 
 void GxEPD2_it103_1872x1404::writeScreenBuffer(uint8_t value)
@@ -143,17 +146,18 @@ void GxEPD2_it103_1872x1404::writeScreenBuffer(uint8_t value)
 void GxEPD2_it103_1872x1404::_writeScreenBuffer(uint8_t value)
 {
   _initial_write = false; // initial full screen buffer clean done
+  _grey_written = _grey_written || (((value >> 4) != 0x00) && ((value >> 4) != 0x0F));
   if (!_using_partial_mode) _Init_Part();
-  _setPartialRamArea(0, 0, WIDTH, HEIGHT);
+  _setPartialRamArea(0, 0, WIDTH, HEIGHT, IT8951_4BPP);
   SPI.beginTransaction(_spi_settings);
   if (_cs >= 0) digitalWrite(_cs, LOW);
   _transfer16(0x0000); // preamble for write data
   _waitWhileBusy2("clearScreen preamble", default_wait_time);
-  for (uint32_t i = 0; i < uint32_t(WIDTH) * uint32_t(HEIGHT); i++)
+  for (uint16_t i = 0; i < HEIGHT; i++)
   {
-    SPI.transfer(value);
+    _transferFill(SPI, (value & 0xF0) | (value >> 4), WIDTH / 2); // 4bpp, 16 grey levels are used of 8bpp
 #if defined(ESP8266) || defined(ESP32)
-    if (0 == i % 10000) yield();
+    if (0 == i % 8) yield();
 #endif
   }
   if (_cs >= 0) digitalWrite(_cs, HIGH);
@@ -179,7 +183,7 @@ void GxEPD2_it103_1872x1404::writeImage(const uint8_t bitmap[], int16_t x, int16
   h1 -= dy;
   if ((w1 <= 0) || (h1 <= 0)) return;
   if (!_using_partial_mode) _Init_Part();
-  _setPartialRamArea(x1, y1, w1, h1);
+  _setPartialRamArea(x1, y1, w1, h1, IT8951_2BPP);
   SPI.beginTransaction(_spi_settings);
   if (_cs >= 0) digitalWrite(_cs, LOW);
   _transfer16(0x0000); // preamble for write data
@@ -241,7 +245,7 @@ void GxEPD2_it103_1872x1404::writeImagePart(const uint8_t bitmap[], int16_t x_pa
   h1 -= dy;
   if ((w1 <= 0) || (h1 <= 0)) return;
   if (!_using_partial_mode) _Init_Part();
-  _setPartialRamArea(x1, y1, w1, h1);
+  _setPartialRamArea(x1, y1, w1, h1, IT8951_2BPP);
   SPI.beginTransaction(_spi_settings);
   if (_cs >= 0) digitalWrite(_cs, LOW);
   _transfer16(0x0000); // preamble for write data
@@ -309,33 +313,19 @@ void GxEPD2_it103_1872x1404::writeNative(const uint8_t* data1, const uint8_t* da
     h1 -= dy;
     if ((w1 <= 0) || (h1 <= 0)) return;
     if (!_using_partial_mode) _Init_Part();
-    _setPartialRamArea(x1, y1, w1, h1);
+    _grey_written = true;
+    bool packed = (0 == ((x1 | w1) & 3)); // 4bpp loads whole 16 bit words
+    _setPartialRamArea(x1, y1, w1, h1, packed ? IT8951_4BPP : IT8951_8BPP);
     SPI.beginTransaction(_spi_settings);
     if (_cs >= 0) digitalWrite(_cs, LOW);
     _transfer16(0x0000); // preamble for write data
     _waitWhileBusy2("writeNative preamble", default_wait_time);
     for (int16_t i = 0; i < h1; i++)
     {
-      for (int16_t j = 0; j < w1; j++)
-      {
-        uint8_t data;
-        // use w, h of bitmap for index!
-        uint32_t idx = mirror_y ? uint32_t(j + dx) + uint32_t((h - 1 - (i + dy))) * uint32_t(w) : uint32_t(j + dx) + uint32_t(i + dy) * uint32_t(w);
-        if (pgm)
-        {
-#if defined(__AVR) || defined(ESP8266) || defined(ESP32)
-          data = pgm_read_byte(&data1[idx]);
-#else
-          data = data1[idx];
-#endif
-        }
-        else
-        {
-          data = data1[idx];
-        }
-        if (invert) data = ~data;
-        SPI.transfer(data);
-      }
+      // use w, h of bitmap for index!
+      uint32_t idx = mirror_y ? uint32_t(dx) + uint32_t((h - 1 - (i + dy))) * uint32_t(w) : uint32_t(dx) + uint32_t(i + dy) * uint32_t(w);
+      if (packed) _send4bppRow(&data1[idx], w1, invert, pgm);
+      else _transferRow(SPI, &data1[idx], w1, invert, pgm);
 #if defined(ESP8266) || defined(ESP32)
       yield();
 #endif
@@ -348,49 +338,124 @@ void GxEPD2_it103_1872x1404::writeNative(const uint8_t* data1, const uint8_t* da
   }
 }
 
+void GxEPD2_it103_1872x1404::writeImage4bpp(const uint8_t bitmap[], int16_t x, int16_t y, int16_t w, int16_t h, bool invert, bool mirror_y, bool pgm)
+{
+  writeImagePart4bpp(bitmap, 0, 0, w, h, x, y, w, h, invert, mirror_y, pgm);
+}
+
+void GxEPD2_it103_1872x1404::writeImagePart4bpp(const uint8_t bitmap[], int16_t x_part, int16_t y_part, int16_t w_bitmap, int16_t h_bitmap,
+    int16_t x, int16_t y, int16_t w, int16_t h, bool invert, bool mirror_y, bool pgm)
+{
+  if (_initial_write) writeScreenBuffer(); // initial full screen buffer clean
+  delay(1); // yield() to avoid WDT on ESP8266 and ESP32
+  if ((w_bitmap < 0) || (h_bitmap < 0) || (w < 0) || (h < 0)) return;
+  if ((x_part < 0) || (x_part >= w_bitmap)) return;
+  if ((y_part < 0) || (y_part >= h_bitmap)) return;
+  int16_t wb_bitmap = (w_bitmap + 1) / 2; // width bytes, bitmaps are padded
+  x_part -= x_part % 2; // byte boundary
+  w = w_bitmap - x_part < w ? w_bitmap - x_part : w; // limit
+  h = h_bitmap - y_part < h ? h_bitmap - y_part : h; // limit
+  x -= x % 4; // 4bpp loads whole 16 bit words
+  w = 4 * ((w + 3) / 4); // padded with white beyond the bitmap
+  int16_t x1 = x < 0 ? 0 : x; // limit
+  int16_t y1 = y < 0 ? 0 : y; // limit
+  int16_t w1 = x + w < int16_t(WIDTH) ? w : int16_t(WIDTH) - x; // limit
+  int16_t h1 = y + h < int16_t(HEIGHT) ? h : int16_t(HEIGHT) - y; // limit
+  int16_t dx = x1 - x;
+  int16_t dy = y1 - y;
+  w1 -= dx;
+  h1 -= dy;
+  if ((w1 <= 0) || (h1 <= 0)) return;
+  if (!_using_partial_mode) _Init_Part();
+  _grey_written = true;
+  _setPartialRamArea(x1, y1, w1, h1, IT8951_4BPP);
+  SPI.beginTransaction(_spi_settings);
+  if (_cs >= 0) digitalWrite(_cs, LOW);
+  _transfer16(0x0000); // preamble for write data
+  _waitWhileBusy2("writeImage4bpp preamble", default_wait_time);
+  int16_t n = wb_bitmap - (x_part + dx) / 2; // bytes of the bitmap row
+  if (n > w1 / 2) n = w1 / 2;
+  for (int16_t i = 0; i < h1; i++)
+  {
+    // use wb_bitmap, h_bitmap of bitmap for index!
+    uint32_t idx = mirror_y ? (x_part + dx) / 2 + uint32_t((h_bitmap - 1 - (y_part + i + dy))) * uint32_t(wb_bitmap) : (x_part + dx) / 2 + uint32_t(y_part + i + dy) * uint32_t(wb_bitmap);
+    if (n > 0) _transferRow(SPI, &bitmap[idx], n, invert, pgm);
+    if (n < w1 / 2) _transferFill(SPI, 0xFF, w1 / 2 - (n > 0 ? n : 0));
+#if defined(ESP8266) || defined(ESP32)
+    yield();
+#endif
+  }
+  if (_cs >= 0) digitalWrite(_cs, HIGH);
+  SPI.endTransaction();
+  _writeCommand16(IT8951_TCON_LD_IMG_END);
+  _waitWhileBusy2("writeImage4bpp load end", default_wait_time);
+  delay(1); // yield() to avoid WDT on ESP8266 and ESP32
+}
+
 void GxEPD2_it103_1872x1404::drawImage(const uint8_t bitmap[], int16_t x, int16_t y, int16_t w, int16_t h, bool invert, bool mirror_y, bool pgm)
 {
   writeImage(bitmap, x, y, w, h, invert, mirror_y, pgm);
-  _refresh(x, y, w, h, true);
+  _refresh(x, y, w, h, _partialRefreshMode());
 }
 
 void GxEPD2_it103_1872x1404::drawImagePart(const uint8_t bitmap[], int16_t x_part, int16_t y_part, int16_t w_bitmap, int16_t h_bitmap,
     int16_t x, int16_t y, int16_t w, int16_t h, bool invert, bool mirror_y, bool pgm)
 {
   writeImagePart(bitmap, x_part, y_part, w_bitmap, h_bitmap, x, y, w, h, invert, mirror_y, pgm);
-  _refresh(x, y, w, h, true);
+  _refresh(x, y, w, h, _partialRefreshMode());
 }
 
 void GxEPD2_it103_1872x1404::drawImage(const uint8_t* black, const uint8_t* color, int16_t x, int16_t y, int16_t w, int16_t h, bool invert, bool mirror_y, bool pgm)
 {
   writeImage(black, color, x, y, w, h, invert, mirror_y, pgm);
-  _refresh(x, y, w, h, true);
+  _refresh(x, y, w, h, _partialRefreshMode());
 }
 
 void GxEPD2_it103_1872x1404::drawImagePart(const uint8_t* black, const uint8_t* color, int16_t x_part, int16_t y_part, int16_t w_bitmap, int16_t h_bitmap,
     int16_t x, int16_t y, int16_t w, int16_t h, bool invert, bool mirror_y, bool pgm)
 {
   writeImagePart(black, color, x_part, y_part, w_bitmap, h_bitmap, x, y, w, h, invert, mirror_y, pgm);
-  _refresh(x, y, w, h, true);
+  _refresh(x, y, w, h, _partialRefreshMode());
 }
 
 void GxEPD2_it103_1872x1404::drawNative(const uint8_t* data1, const uint8_t* data2, int16_t x, int16_t y, int16_t w, int16_t h, bool invert, bool mirror_y, bool pgm)
 {
   writeNative(data1, data2, x, y, w, h, invert, mirror_y, pgm);
-  _refresh(x, y, w, h, false);
+  _refresh(x, y, w, h, GC16_MODE);
 }
 
 void GxEPD2_it103_1872x1404::refresh(bool partial_update_mode)
 {
-  _refresh(0, 0, WIDTH, HEIGHT, partial_update_mode);
+  _refresh(0, 0, WIDTH, HEIGHT, partial_update_mode ? _partialRefreshMode() : uint16_t(GC16_MODE));
 }
 
 void GxEPD2_it103_1872x1404::refresh(int16_t x, int16_t y, int16_t w, int16_t h)
 {
-  _refresh(x, y, w, h, true);
+  _refresh(x, y, w, h, _partialRefreshMode());
 }
 
-void GxEPD2_it103_1872x1404::_refresh(int16_t x, int16_t y, int16_t w, int16_t h, bool partial_update_mode)
+void GxEPD2_it103_1872x1404::refresh(int16_t x, int16_t y, int16_t w, int16_t h, RefreshMode mode)
+{
+  _refresh(x, y, w, h, (AUTO_MODE == mode) ? _partialRefreshMode() : _waveformMode(mode));
+}
+
+void GxEPD2_it103_1872x1404::setRefreshMode(RefreshMode mode)
+{
+  _refresh_mode = mode;
+}
+
+uint16_t GxEPD2_it103_1872x1404::_waveformMode(RefreshMode mode)
+{
+  return (A2_MODE == mode) ? _a2_mode : uint16_t(mode);
+}
+
+uint16_t GxEPD2_it103_1872x1404::_partialRefreshMode()
+{
+  if (AUTO_MODE != _refresh_mode) return _waveformMode(_refresh_mode);
+  return _grey_written ? GL16_MODE : DU_MODE;
+}
+
+void GxEPD2_it103_1872x1404::_refresh(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t mode)
 {
   //x -= x % 8; // byte boundary
   //w -= x % 8; // byte boundary
@@ -403,16 +468,10 @@ void GxEPD2_it103_1872x1404::_refresh(int16_t x, int16_t y, int16_t w, int16_t h
   //Send I80 Display Command (User defined command of IT8951)
   _writeCommand16(USDEF_I80_CMD_DPY_AREA); //0x0034
   _waitWhileBusy2("refresh cmd", refresh_cmd_time);
-  //Write arguments
-  _writeData16(x1);
-  _waitWhileBusy2("refresh x", refresh_par_time);
-  _writeData16(y1);
-  _waitWhileBusy2("refresh y", refresh_par_time);
-  _writeData16(w1);
-  _waitWhileBusy2("refresh w", refresh_par_time);
-  _writeData16(h1);
-  _waitWhileBusy2("refresh h", refresh_par_time);
-  _writeData16(partial_update_mode ? 1 : 2); // mode
+  //Write arguments, in one burst
+  uint16_t usArg[5] = {uint16_t(x1), uint16_t(y1), uint16_t(w1), uint16_t(h1), mode};
+  _writeData16(usArg, 5, refresh_par_time);
+  _grey_written = false;
   _waitWhileBusy("refresh", full_refresh_time);
 }
 
@@ -434,22 +493,57 @@ void GxEPD2_it103_1872x1404::hibernate()
   }
 }
 
+// packed pixels: the first pixel in the high bits of a byte, bytes in address order, as with 8bpp.
+// the load expands them to the 8bpp image buffer, of which the display uses the high nibble.
+
 void GxEPD2_it103_1872x1404::_send8pixel(uint8_t data)
 {
-  for (uint8_t j = 0; j < 8; j++)
+  // 2bpp: 0 for black (bit set), 3 for white
+  static const uint8_t pixel_pairs[16] = {0xFF, 0xFC, 0xF3, 0xF0, 0xCF, 0xCC, 0xC3, 0xC0, 0x3F, 0x3C, 0x33, 0x30, 0x0F, 0x0C, 0x03, 0x00};
+  uint8_t pixels[2] = {pixel_pairs[data >> 4], pixel_pairs[data & 0x0F]};
+  _transferRow(SPI, pixels, 2);
+}
+
+void GxEPD2_it103_1872x1404::_send4bppRow(const uint8_t* data, uint32_t n, bool invert, bool pgm)
+{
+  // 4bpp from 8bpp native data, n pixels, even
+  uint8_t pixels[32];
+  while (n > 0)
   {
-    SPI.transfer(data & 0x80 ? 0x00 : 0xFF);
-    data <<= 1;
+    uint32_t k = n < 2 * sizeof(pixels) ? n : 2 * sizeof(pixels);
+    for (uint32_t i = 0; i < k / 2; i++)
+    {
+      uint8_t p0, p1;
+      if (pgm)
+      {
+#if defined(__AVR) || defined(ESP8266) || defined(ESP32)
+        p0 = pgm_read_byte(&data[2 * i]);
+        p1 = pgm_read_byte(&data[2 * i + 1]);
+#else
+        p0 = data[2 * i];
+        p1 = data[2 * i + 1];
+#endif
+      }
+      else
+      {
+        p0 = data[2 * i];
+        p1 = data[2 * i + 1];
+      }
+      pixels[i] = (p0 & 0xF0) | (p1 >> 4);
+    }
+    _transferRow(SPI, pixels, k / 2, invert);
+    data += k;
+    n -= k;
   }
 }
 
-void GxEPD2_it103_1872x1404::_setPartialRamArea(uint16_t x, uint16_t y, uint16_t w, uint16_t h)
+void GxEPD2_it103_1872x1404::_setPartialRamArea(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint16_t pixel_format)
 {
   //_IT8951WriteReg(LISAR + 2 , IT8951DevInfo.usImgBufAddrH);
   //_IT8951WriteReg(LISAR , IT8951DevInfo.usImgBufAddrL);
   uint16_t usArg[5];
   //usArg[0] = (IT8951_LDIMG_L_ENDIAN << 8 ) | (IT8951_8BPP << 4) | (IT8951_ROTATE_0);
-  usArg[0] = (IT8951_LDIMG_B_ENDIAN << 8 ) | (IT8951_8BPP << 4) | (IT8951_ROTATE_0);
+  usArg[0] = (IT8951_LDIMG_B_ENDIAN << 8 ) | (pixel_format << 4) | (IT8951_ROTATE_0);
   usArg[1] = x;
   usArg[2] = y;
   usArg[3] = w;
@@ -509,7 +603,9 @@ void GxEPD2_it103_1872x1404::_waitWhileBusy2(const char* comment, uint16_t busy_
     while (1)
     {
       if (digitalRead(_busy) != _busy_level) break;
-      delay(1);
+      // HRDY handshakes take microseconds: poll at that granularity for the first ms
+      if (micros() - start < 1000) delayMicroseconds(10);
+      else delay(1);
       if (micros() - start > _busy_timeout)
       {
         Serial.println("Busy Timeout!");
@@ -544,8 +640,15 @@ uint16_t GxEPD2_it103_1872x1404::_transfer16(uint16_t value)
 
 void GxEPD2_it103_1872x1404::_writeCommand16(uint16_t c)
 {
-  String s = String("_writeCommand16(0x") + String(c, HEX) + String(")");
-  _waitWhileBusy2(s.c_str(), default_wait_time);
+#if !defined(DISABLE_DIAGNOSTIC_OUTPUT)
+  if (_diag_enabled)
+  {
+    String s = String("_writeCommand16(0x") + String(c, HEX) + String(")");
+    _waitWhileBusy2(s.c_str(), default_wait_time);
+  }
+  else
+#endif
+    _waitWhileBusy2("_writeCommand16", default_wait_time);
   SPI.beginTransaction(_spi_settings);
   if (_cs >= 0) digitalWrite(_cs, LOW);
   _transfer16(0x6000); // preamble for write command
@@ -568,15 +671,15 @@ void GxEPD2_it103_1872x1404::_writeData16(uint16_t d)
   SPI.endTransaction();
 }
 
-void GxEPD2_it103_1872x1404::_writeData16(const uint16_t* d, uint32_t n)
+void GxEPD2_it103_1872x1404::_writeData16(const uint16_t* d, uint32_t n, uint16_t busy_time)
 {
-  _waitWhileBusy2("_writeData16", default_wait_time);
+  _waitWhileBusy2("_writeData16", busy_time);
   SPI.beginTransaction(_spi_settings);
   if (_cs >= 0) digitalWrite(_cs, LOW);
   _transfer16(0x0000); // preamble for write data
-  _waitWhileBusy2("_writeData16 preamble", default_wait_time);
   for (uint32_t i = 0; i < n; i++)
   {
+    _waitWhileBusy2("_writeData16 burst", busy_time); // HRDY before each word
     _transfer16(*d++);
   }
   if (_cs >= 0) digitalWrite(_cs, HIGH);
@@ -619,10 +722,7 @@ void GxEPD2_it103_1872x1404::_readData16(uint16_t* d, uint32_t n)
 void GxEPD2_it103_1872x1404::_writeCommandData16(uint16_t c, const uint16_t* d, uint16_t n)
 {
   _writeCommand16(c);
-  for (uint16_t i = 0; i < n; i++)
-  {
-    _writeData16(d[i]);
-  }
+  _writeData16(d, n);
 }
 
 void GxEPD2_it103_1872x1404::_IT8951SystemRun()
@@ -655,9 +755,8 @@ uint16_t GxEPD2_it103_1872x1404::_IT8951ReadReg(uint16_t usRegAddr)
 void GxEPD2_it103_1872x1404::_IT8951WriteReg(uint16_t usRegAddr, uint16_t usValue)
 {
   //Send Cmd , Register Address and Write Value
-  _writeCommand16(IT8951_TCON_REG_WR);
-  _writeData16(usRegAddr);
-  _writeData16(usValue);
+  uint16_t usArg[2] = {usRegAddr, usValue};
+  _writeCommandData16(IT8951_TCON_REG_WR, usArg, 2);
 }
 
 uint16_t GxEPD2_it103_1872x1404::_IT8951GetVCOM(void)
@@ -676,8 +775,7 @@ void GxEPD2_it103_1872x1404::_IT8951SetVCOM(uint16_t vcom)
 {
   _writeCommand16(USDEF_I80_CMD_VCOM);
   _waitWhileBusy2("_IT8951SetVCOM", default_wait_time);
-  _writeData16(1);
-  //Read data from Host Data bus
-  _writeData16(vcom);
+  uint16_t usArg[2] = {1, vcom};
+  _writeData16(usArg, 2);
   _waitWhileBusy2("_IT8951SetVCOM", set_vcom_time);
 }
@@ -30,6 +30,7 @@ class GxEPD2_it78_1872x1404 : public GxEPD2_EPD
     static const bool hasColor = false;
     static const bool hasPartialUpdate = true;
     static const bool hasFastPartialUpdate = true;
+    static const bool hasPreviousImageSync = true; // single image buffer
     static const uint16_t reset_to_ready_time = 1800; // ms, e.g. 1729001us
     static const uint16_t power_on_time = 10; // ms, e.g. 3001us
     static const uint16_t power_off_time = 250; // ms, e.g. 214001us
@@ -55,8 +56,18 @@ class GxEPD2_it78_1872x1404 : public GxEPD2_EPD
     void writeImage(const uint8_t* black, const uint8_t* color, int16_t x, int16_t y, int16_t w, int16_t h, bool invert = false, bool mirror_y = false, bool pgm = false);
     void writeImagePart(const uint8_t* black, const uint8_t* color, int16_t x_part, int16_t y_part, int16_t w_bitmap, int16_t h_bitmap,
                         int16_t x, int16_t y, int16_t w, int16_t h, bool invert = false, bool mirror_y = false, bool pgm = false);
+    // for differential update: set current and previous buffers equal (for fast partial update to work correctly)
+    // single image buffer, nothing to do; override with empty code
+    void writeImageAgain(const uint8_t bitmap[], int16_t x, int16_t y, int16_t w, int16_t h, bool invert = false, bool mirror_y = false, bool pgm = false) {};
+    void writeImagePartAgain(const uint8_t bitmap[], int16_t x_part, int16_t y_part, int16_t w_bitmap, int16_t h_bitmap,
+                             int16_t x, int16_t y, int16_t w, int16_t h, bool invert = false, bool mirror_y = false, bool pgm = false) {};
     // write sprite of native data to controller memory, without screen refresh; x and w should be multiple of 8
     void writeNative(const uint8_t* data1, const uint8_t* data2, int16_t x, int16_t y, int16_t w, int16_t h, bool invert = false, bool mirror_y = false, bool pgm = false);
+    // write 4bpp grey levels to controller memory, without screen refresh; x and w should be multiple of 4, as used by GxEPD2_16G
+    // 2 pixels per byte, the first in the high nibble, 0x0 black to 0xF white; rows are padded to whole bytes
+    void writeImage4bpp(const uint8_t bitmap[], int16_t x, int16_t y, int16_t w, int16_t h, bool invert = false, bool mirror_y = false, bool pgm = false);
+    void writeImagePart4bpp(const uint8_t bitmap[], int16_t x_part, int16_t y_part, int16_t w_bitmap, int16_t h_bitmap,
+                            int16_t x, int16_t y, int16_t w, int16_t h, bool invert = false, bool mirror_y = false, bool pgm = false);
     // write to controller memory, with screen refresh; x and w should be multiple of 8
     void drawImage(const uint8_t bitmap[], int16_t x, int16_t y, int16_t w, int16_t h, bool invert = false, bool mirror_y = false, bool pgm = false);
     void drawImagePart(const uint8_t bitmap[], int16_t x_part, int16_t y_part, int16_t w_bitmap, int16_t h_bitmap,
@@ -68,6 +79,13 @@ class GxEPD2_it78_1872x1404 : public GxEPD2_EPD
     void drawNative(const uint8_t* data1, const uint8_t* data2, int16_t x, int16_t y, int16_t w, int16_t h, bool invert = false, bool mirror_y = false, bool pgm = false);
     void refresh(bool partial_update_mode = false); // screen refresh from controller memory to full screen
     void refresh(int16_t x, int16_t y, int16_t w, int16_t h); // screen refresh from controller memory, partial screen
+    // waveform modes of the IT8951 LUT: A2 and DU for b/w, A2 is fastest but leaves more ghosting; GL16 and GC16 for grey levels
+    enum RefreshMode {INIT_MODE = 0, DU_MODE = 1, GC16_MODE = 2, GL16_MODE = 3, A2_MODE = 0xFE, AUTO_MODE = 0xFF};
+    // screen refresh from controller memory, partial screen, with waveform mode, AUTO_MODE as selected by setRefreshMode()
+    void refresh(int16_t x, int16_t y, int16_t w, int16_t h, RefreshMode mode);
+    // waveform mode of partial refresh, also of the display templates; full refresh uses GC16;
+    // AUTO_MODE, the default: DU if only b/w content was written since the last refresh, else GL16
+    void setRefreshMode(RefreshMode mode = AUTO_MODE);
     void powerOff(); // turns off generation of panel driving voltages, avoids screen fading over time
     void hibernate(); // turns powerOff() and sets controller to deep sleep for minimum power use, ONLY if wakeable by RST (rst >= 0)
   private:
@@ -83,11 +101,17 @@ class GxEPD2_it78_1872x1404 : public GxEPD2_EPD
     IT8951DevInfoStruct IT8951DevInfo;
     SPISettings _spi_settings;
     SPISettings _spi_settings_for_read;
+    RefreshMode _refresh_mode;
+    uint16_t _a2_mode;
+    bool _grey_written;
   private:
     void _writeScreenBuffer(uint8_t value);
-    void _refresh(int16_t x, int16_t y, int16_t w, int16_t h, bool partial_update_mode);
+    void _refresh(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t mode);
+    uint16_t _waveformMode(RefreshMode mode);
+    uint16_t _partialRefreshMode();
     void _send8pixel(uint8_t data);
-    void _setPartialRamArea(uint16_t x, uint16_t y, uint16_t w, uint16_t h);
+    void _send4bppRow(const uint8_t* data, uint32_t n, bool invert, bool pgm);
+    void _setPartialRamArea(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint16_t pixel_format);
     void _PowerOn();
     void _PowerOff();
     void _InitDisplay();
@@ -98,7 +122,7 @@ class GxEPD2_it78_1872x1404 : public GxEPD2_EPD
     uint16_t _transfer16(uint16_t value);
     void _writeCommand16(uint16_t c);
     void _writeData16(uint16_t d);
-    void _writeData16(const uint16_t* d, uint32_t n);
+    void _writeData16(const uint16_t* d, uint32_t n, uint16_t busy_time = default_wait_time); // burst paced by HRDY
     uint16_t _readData16();
     void _readData16(uint16_t* d, uint32_t n);
     void _writeCommandData16(uint16_t c, const uint16_t* d, uint16_t n);